@@ -0,0 +1,15 @@
+# Copyright (c) Darrell Wright
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+# Official repository: https://github.com/beached/daw_json_link_data_gen
+#
+
+# Print the size of each object file in OBJECTS, separated by |
+string( REPLACE "|" ";" object_files "${OBJECTS}" )
+foreach( object_file ${object_files} )
+    file( SIZE "${object_file}" object_size )
+    get_filename_component( object_name "${object_file}" NAME )
+    message( STATUS "${object_name}: ${object_size} bytes" )
+endforeach()
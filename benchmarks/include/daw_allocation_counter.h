@@ -0,0 +1,102 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+
+#pragma once
+
+// Replaces the global operator new/delete, include in exactly one translation
+// unit of an executable
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace daw::bench {
+	struct allocation_counters {
+		std::atomic<std::size_t> allocations{ 0 };
+		std::atomic<std::size_t> live_bytes{ 0 };
+		std::atomic<std::size_t> peak_bytes{ 0 };
+	};
+
+	inline allocation_counters &get_allocation_counters( ) {
+		static auto counters = allocation_counters{ };
+		return counters;
+	}
+
+	struct allocation_snapshot {
+		std::size_t allocations;
+		std::size_t live_bytes;
+		std::size_t peak_bytes;
+	};
+
+	inline allocation_snapshot allocation_snapshot_now( ) {
+		auto &c = get_allocation_counters( );
+		return { c.allocations.load( ), c.live_bytes.load( ),
+		         c.peak_bytes.load( ) };
+	}
+
+	/// @brief Start tracking a new peak from the current live size
+	inline void reset_allocation_peak( ) {
+		auto &c = get_allocation_counters( );
+		c.peak_bytes = c.live_bytes.load( );
+	}
+
+	namespace alloc_details {
+		// The size is stored in front of each block so delete can account for it
+		inline constexpr std::size_t header_size = alignof( std::max_align_t );
+
+		inline void *counted_alloc( std::size_t sz ) {
+			auto *p = static_cast<unsigned char *>( std::malloc( sz + header_size ) );
+			if( not p ) {
+				throw std::bad_alloc( );
+			}
+			*reinterpret_cast<std::size_t *>( p ) = sz;
+			auto &c = get_allocation_counters( );
+			++c.allocations;
+			auto const live = c.live_bytes += sz;
+			auto peak = c.peak_bytes.load( );
+			while( live > peak and
+			       not c.peak_bytes.compare_exchange_weak( peak, live ) ) {}
+			return p + header_size;
+		}
+
+		inline void counted_free( void *ptr ) noexcept {
+			if( not ptr ) {
+				return;
+			}
+			auto *p = static_cast<unsigned char *>( ptr ) - header_size;
+			get_allocation_counters( ).live_bytes -=
+			  *reinterpret_cast<std::size_t *>( p );
+			std::free( p );
+		}
+	} // namespace alloc_details
+} // namespace daw::bench
+
+void *operator new( std::size_t sz ) {
+	return daw::bench::alloc_details::counted_alloc( sz );
+}
+
+void *operator new[]( std::size_t sz ) {
+	return daw::bench::alloc_details::counted_alloc( sz );
+}
+
+void operator delete( void *ptr ) noexcept {
+	daw::bench::alloc_details::counted_free( ptr );
+}
+
+void operator delete[]( void *ptr ) noexcept {
+	daw::bench::alloc_details::counted_free( ptr );
+}
+
+void operator delete( void *ptr, std::size_t ) noexcept {
+	daw::bench::alloc_details::counted_free( ptr );
+}
+
+void operator delete[]( void *ptr, std::size_t ) noexcept {
+	daw::bench::alloc_details::counted_free( ptr );
+}
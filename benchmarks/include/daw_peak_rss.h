@@ -0,0 +1,49 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+
+#pragma once
+
+#include <cstddef>
+
+#if defined( _WIN32 )
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace daw::bench {
+	/// @brief The largest resident set size of the process so far in bytes, 0
+	/// when the platform does not report it.  It never decreases, so it is the
+	/// peak of everything that ran before
+	inline std::size_t peak_rss_bytes( ) {
+#if defined( _WIN32 )
+		PROCESS_MEMORY_COUNTERS counters{ };
+		if( not K32GetProcessMemoryInfo( GetCurrentProcess( ), &counters,
+		                                 sizeof( counters ) ) ) {
+			return 0;
+		}
+		return static_cast<std::size_t>( counters.PeakWorkingSetSize );
+#else
+		struct rusage usage { };
+		if( getrusage( RUSAGE_SELF, &usage ) != 0 ) {
+			return 0;
+		}
+#if defined( __APPLE__ )
+		// Bytes on macOS, kilobytes elsewhere
+		return static_cast<std::size_t>( usage.ru_maxrss );
+#else
+		return static_cast<std::size_t>( usage.ru_maxrss ) * 1024U;
+#endif
+#endif
+	}
+} // namespace daw::bench
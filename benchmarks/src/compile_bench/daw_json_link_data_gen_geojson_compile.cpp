@@ -0,0 +1,37 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+// Instantiates what is generated for the geojson schema: values, values to
+// a size target, regeneration and JSON text, for
+// daw_json_link_data_gen_compile_bench to time and measure
+
+#include "geojson_json.h"
+
+#include <daw/json/daw_json_link_data_gen.h>
+#include <daw/json/daw_json_link_data_generator.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+using geojson_t = daw::geojson::FeatureCollection;
+
+geojson_t geojson_value( std::uint64_t seed ) {
+	return daw::data_gen::data_generator<geojson_t>( seed )( );
+}
+
+geojson_t geojson_value_of_size( std::size_t target_size ) {
+	return daw::data_gen::generate_data_for<geojson_t>( target_size );
+}
+
+void geojson_regenerate( geojson_t &value, std::uint64_t seed ) {
+	daw::data_gen::data_generator<geojson_t>( seed ).generate_into( value );
+}
+
+std::string &geojson_json( std::string &out ) {
+	return daw::data_gen::generate_json_for<geojson_t>( out );
+}
@@ -0,0 +1,32 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+// Instantiates JSON generation of the bundled schemas with the template
+// path, generate_json_for, for daw_json_link_data_gen_compile_bench to
+// time
+
+#include "citm_test_json.h"
+#include "geojson_json.h"
+#include "twitter_test_json.h"
+
+#include <daw/json/daw_json_link_data_gen.h>
+
+#include <string>
+
+using daw::data_gen::generate_json_for;
+
+std::string &template_geojson( std::string &out ) {
+	return generate_json_for<daw::geojson::FeatureCollection>( out );
+}
+
+std::string &template_twitter( std::string &out ) {
+	return generate_json_for<daw::twitter::twitter_object_t>( out );
+}
+
+std::string &template_citm( std::string &out ) {
+	return generate_json_for<daw::citm::citm_object_t>( out );
+}
@@ -0,0 +1,148 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+// Measures the heap bytes held by each generated document and compares it to
+// the size of the document's JSON.  Generated values should not hold much more
+// memory than the data they represent, e.g. over reserving strings shows up
+// here as a large ratio.  Also checks that generating JSON into a fixed buffer
+// does not allocate and that regenerating in place allocates less than
+// generating new documents.
+
+#include "citm_test_json.h"
+#include "daw_allocation_counter.h"
+#include "geojson_json.h"
+#include "twitter_test_json.h"
+
+#include <daw/json/daw_json_link_data_gen.h>
+#include <daw/json/daw_json_link_data_generator.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Heap bytes per byte of JSON allowed before the benchmark reports a failure
+inline constexpr double max_heap_to_json_ratio = 4.0;
+
+template<typename T>
+bool measure_memory( char const *name, std::size_t doc_count ) {
+	auto eng = std::mt19937_64( 42 );
+	auto docs = std::vector<T>( );
+	docs.reserve( doc_count );
+
+	auto const before = daw::bench::allocation_snapshot_now( );
+	for( std::size_t n = 0; n < doc_count; ++n ) {
+		docs.push_back( daw::data_gen::generate_data_for<T>( eng ) );
+	}
+	auto const after = daw::bench::allocation_snapshot_now( );
+
+	std::size_t json_bytes = 0;
+	for( auto const &doc : docs ) {
+		json_bytes += daw::json::to_json( doc ).size( );
+	}
+	auto const heap_bytes = after.live_bytes - before.live_bytes;
+	auto const heap_per_doc =
+	  static_cast<double>( heap_bytes ) / static_cast<double>( doc_count );
+	auto const json_per_doc =
+	  static_cast<double>( json_bytes ) / static_cast<double>( doc_count );
+	auto const allocs_per_doc =
+	  static_cast<double>( after.allocations - before.allocations ) /
+	  static_cast<double>( doc_count );
+	auto const ratio = heap_per_doc / json_per_doc;
+	std::printf( "%-16s heap bytes/doc: %12.0f  json bytes/doc: %12.0f  "
+	             "heap/json: %6.2f  allocations/doc: %10.0f\n",
+	             name, heap_per_doc, json_per_doc, ratio, allocs_per_doc );
+	return ratio <= max_heap_to_json_ratio;
+}
+
+template<typename T>
+bool measure_bounded_allocations( char const *name, std::size_t doc_count ) {
+	auto eng = std::mt19937_64( 42 );
+	auto buffer = std::vector<char>( 64U * 1024U );
+	std::size_t json_bytes = 0;
+
+	auto const before = daw::bench::allocation_snapshot_now( );
+	for( std::size_t n = 0; n < doc_count; ++n ) {
+		json_bytes += daw::data_gen::generate_json_into<T>( buffer, eng );
+	}
+	auto const after = daw::bench::allocation_snapshot_now( );
+
+	auto const allocations = after.allocations - before.allocations;
+	std::printf( "%-16s bounded json bytes/doc: %12.0f  allocations: %zu\n",
+	             name,
+	             static_cast<double>( json_bytes ) /
+	               static_cast<double>( doc_count ),
+	             allocations );
+	return allocations == 0;
+}
+
+template<typename T>
+bool measure_regenerate_allocations( char const *name,
+                                     std::size_t doc_count ) {
+	auto gen = daw::data_gen::data_generator<T, std::mt19937_64>( 42 );
+	auto doc = gen( );
+	// Let the document grow to the lengths being generated
+	for( std::size_t n = 0; n < doc_count; ++n ) {
+		gen.generate_into( doc );
+	}
+	auto const before = daw::bench::allocation_snapshot_now( );
+	for( std::size_t n = 0; n < doc_count; ++n ) {
+		gen.generate_into( doc );
+	}
+	auto const middle = daw::bench::allocation_snapshot_now( );
+	for( std::size_t n = 0; n < doc_count; ++n ) {
+		doc = gen( );
+	}
+	auto const after = daw::bench::allocation_snapshot_now( );
+
+	auto const regenerate_allocs =
+	  static_cast<double>( middle.allocations - before.allocations ) /
+	  static_cast<double>( doc_count );
+	auto const generate_allocs =
+	  static_cast<double>( after.allocations - middle.allocations ) /
+	  static_cast<double>( doc_count );
+	std::printf( "%-16s allocations/doc regenerate: %10.0f  generate: %10.0f\n",
+	             name, regenerate_allocs, generate_allocs );
+	return regenerate_allocs < generate_allocs;
+}
+
+int main( ) {
+	bool ok = true;
+	ok &= measure_memory<daw::geojson::FeatureCollection>( "geojson", 10 );
+	ok &= measure_memory<daw::twitter::twitter_object_t>( "twitter", 10 );
+	ok &= measure_memory<daw::citm::citm_object_t>( "citm", 10 );
+	if( not ok ) {
+		std::printf( "Generated documents hold more than %.1fx their JSON size "
+		             "in heap memory\n",
+		             max_heap_to_json_ratio );
+		return 1;
+	}
+	// Custom members, e.g. twitter's dates, are written with to_json and may
+	// allocate
+	bool bounded_ok = true;
+	bounded_ok &= measure_bounded_allocations<daw::geojson::FeatureCollection>(
+	  "geojson", 100 );
+	bounded_ok &=
+	  measure_bounded_allocations<daw::citm::citm_object_t>( "citm", 100 );
+	if( not bounded_ok ) {
+		std::printf( "Generating into a fixed buffer allocated\n" );
+		return 1;
+	}
+	bool regenerate_ok = true;
+	regenerate_ok &= measure_regenerate_allocations<
+	  daw::geojson::FeatureCollection>( "geojson", 10 );
+	regenerate_ok &= measure_regenerate_allocations<
+	  daw::twitter::twitter_object_t>( "twitter", 10 );
+	regenerate_ok &=
+	  measure_regenerate_allocations<daw::citm::citm_object_t>( "citm", 10 );
+	if( not regenerate_ok ) {
+		std::printf( "Regenerating allocated as much as generating\n" );
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,48 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+// Times daw_json_link's from_json, to_json and json_value iteration over
+// generated geojson, twitter and citm corpora of several document sizes, see
+// daw_json_link_parse_bench.h.  Usage:
+//   daw_json_link_data_gen_parse_bench [MB per size bucket] [timed runs]
+
+#include "citm_test_json.h"
+#include "geojson_json.h"
+#include "twitter_test_json.h"
+
+#include <daw/json/daw_json_link_parse_bench.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+int main( int argc, char **argv ) {
+	auto opts = daw::data_gen::parse_bench_options{ };
+	if( argc > 1 ) {
+		auto const mb = std::strtod( argv[1], nullptr );
+		if( not( mb > 0.0 ) ) {
+			std::printf( "Usage: %s [MB per size bucket] [timed runs]\n", argv[0] );
+			return 1;
+		}
+		opts.bucket_bytes = static_cast<std::size_t>( mb * 1024.0 * 1024.0 );
+	}
+	if( argc > 2 ) {
+		opts.runs = std::strtoul( argv[2], nullptr, 10 );
+		if( opts.runs == 0 ) {
+			std::printf( "Usage: %s [MB per size bucket] [timed runs]\n", argv[0] );
+			return 1;
+		}
+	}
+	using namespace daw::data_gen;
+	print_parse_bench( "geojson",
+	                   run_parse_bench<daw::geojson::FeatureCollection>( opts ) );
+	print_parse_bench( "twitter",
+	                   run_parse_bench<daw::twitter::twitter_object_t>( opts ) );
+	print_parse_bench( "citm",
+	                   run_parse_bench<daw::citm::citm_object_t>( opts ) );
+	return 0;
+}
@@ -0,0 +1,124 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+// Measures JSON generation throughput for each bundled schema with the
+// template path, generate_json, and with a plan, generate_json_with_plan.
+// Both write into a reused std::string from the same seed, so they write the
+// same documents, which is checked first.  The compile time of each is
+// measured by the daw_json_link_data_gen_compile_bench target.  Usage:
+//   daw_json_link_data_gen_plan_bench [seconds per measurement]
+
+#include "citm_test_json.h"
+#include "data_gen_test_types.h"
+#include "geojson_json.h"
+#include "twitter_test_json.h"
+
+#include <daw/daw_do_not_optimize.h>
+#include <daw/json/daw_json_link_data_gen.h>
+#include <daw/json/daw_json_link_data_generator.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+	using bench_clock = std::chrono::steady_clock;
+
+	inline constexpr std::uint64_t bench_seed = 42;
+
+	struct throughput_result {
+		std::size_t docs = 0;
+		double seconds = 0.0;
+		std::size_t json_bytes = 0;
+	};
+
+	void print_result( char const *name, char const *mode,
+	                   throughput_result const &r ) {
+		std::printf( "%-10s %-8s docs/s: %12.1f  MB/s: %9.2f\n", name, mode,
+		             static_cast<double>( r.docs ) / r.seconds,
+		             static_cast<double>( r.json_bytes ) / r.seconds / 1.0e6 );
+	}
+
+	/// @brief Write documents into a reused string with write_json for at
+	/// least min_seconds
+	template<typename T, typename WriteJson>
+	throughput_result bench_json( double min_seconds, WriteJson write_json ) {
+		auto result = throughput_result{ };
+		auto gen = daw::data_gen::data_generator<T>( bench_seed );
+		auto out = std::string( );
+		auto const start = bench_clock::now( );
+		do {
+			out.clear( );
+			write_json( gen, out );
+			daw::do_not_optimize( out );
+			result.json_bytes += out.size( );
+			++result.docs;
+			result.seconds =
+			  std::chrono::duration<double>( bench_clock::now( ) - start ).count( );
+		} while( result.seconds < min_seconds );
+		return result;
+	}
+
+	template<typename T>
+	bool same_documents( ) {
+		auto templated = daw::data_gen::data_generator<T>( bench_seed );
+		auto planned = daw::data_gen::data_generator<T>( bench_seed );
+		auto expected = std::string( );
+		auto json = std::string( );
+		for( int n = 0; n < 10; ++n ) {
+			expected.clear( );
+			json.clear( );
+			templated.generate_json( expected );
+			planned.generate_json_with_plan( json );
+			if( json != expected ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename T>
+	bool bench_schema( char const *name, double min_seconds ) {
+		if( not same_documents<T>( ) ) {
+			std::printf( "%-10s the plan writes different JSON\n", name );
+			return false;
+		}
+		print_result( name, "template",
+		              bench_json<T>( min_seconds, []( auto &gen, auto &out ) {
+			              gen.generate_json( out );
+		              } ) );
+		print_result( name, "plan",
+		              bench_json<T>( min_seconds, []( auto &gen, auto &out ) {
+			              gen.generate_json_with_plan( out );
+		              } ) );
+		return true;
+	}
+} // namespace
+
+int main( int argc, char **argv ) {
+	double min_seconds = 1.0;
+	if( argc > 1 ) {
+		min_seconds = std::strtod( argv[1], nullptr );
+		if( not( min_seconds > 0.0 ) ) {
+			std::printf( "Usage: %s [seconds per measurement]\n", argv[0] );
+			return 1;
+		}
+	}
+	bool ok = bench_schema<Foo>( "Foo", min_seconds );
+	ok = bench_schema<Bar>( "Bar", min_seconds ) and ok;
+	ok = bench_schema<daw::geojson::FeatureCollection>( "geojson",
+	                                                    min_seconds ) and
+	     ok;
+	ok = bench_schema<daw::twitter::twitter_object_t>( "twitter",
+	                                                   min_seconds ) and
+	     ok;
+	ok = bench_schema<daw::citm::citm_object_t>( "citm", min_seconds ) and ok;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+// Measures generation throughput for each bundled schema: documents/sec, MB/sec
+// of the JSON the documents serialize to, allocations per document and peak
+// memory.  Values are generated with a data_generator, JSON is generated
+// directly into a reused std::string.  Usage:
+//   daw_json_link_data_gen_throughput_bench [seconds per measurement]
+
+#include "citm_test_json.h"
+#include "daw_allocation_counter.h"
+#include "daw_peak_rss.h"
+#include "data_gen_test_types.h"
+#include "geojson_json.h"
+#include "twitter_test_json.h"
+
+#include <daw/daw_do_not_optimize.h>
+#include <daw/json/daw_json_link_data_gen.h>
+#include <daw/json/daw_json_link_data_generator.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+	using bench_clock = std::chrono::steady_clock;
+
+	inline constexpr std::uint64_t bench_seed = 42;
+
+	struct throughput_result {
+		std::size_t docs = 0;
+		double seconds = 0.0;
+		std::size_t json_bytes = 0;
+		std::size_t allocations = 0;
+		std::size_t peak_heap_bytes = 0;
+	};
+
+	void print_result( char const *name, char const *mode,
+	                   throughput_result const &r ) {
+		auto const docs = static_cast<double>( r.docs );
+		std::printf( "%-10s %-5s docs/s: %12.1f  MB/s: %9.2f  allocs/doc: %10.1f  "
+		             "peak heap MB: %8.2f  peak RSS MB: %8.2f\n",
+		             name, mode, docs / r.seconds,
+		             static_cast<double>( r.json_bytes ) / r.seconds / 1.0e6,
+		             static_cast<double>( r.allocations ) / docs,
+		             static_cast<double>( r.peak_heap_bytes ) / 1.0e6,
+		             static_cast<double>( daw::bench::peak_rss_bytes( ) ) / 1.0e6 );
+	}
+
+	/// @brief Generate and destroy documents for at least min_seconds.  The
+	/// JSON size is measured afterwards, untimed, by replaying the same seed
+	template<typename T>
+	throughput_result bench_values( double min_seconds ) {
+		auto result = throughput_result{ };
+		auto gen = daw::data_gen::data_generator<T>( bench_seed );
+		daw::bench::reset_allocation_peak( );
+		auto const before = daw::bench::allocation_snapshot_now( );
+		auto const start = bench_clock::now( );
+		do {
+			auto doc = gen( );
+			daw::do_not_optimize( doc );
+			++result.docs;
+			result.seconds =
+			  std::chrono::duration<double>( bench_clock::now( ) - start ).count( );
+		} while( result.seconds < min_seconds );
+		auto const after = daw::bench::allocation_snapshot_now( );
+		result.allocations = after.allocations - before.allocations;
+		result.peak_heap_bytes = after.peak_bytes - before.live_bytes;
+
+		auto replay = daw::data_gen::data_generator<T>( bench_seed );
+		for( std::size_t n = 0; n < result.docs; ++n ) {
+			result.json_bytes += daw::json::to_json( replay( ) ).size( );
+		}
+		return result;
+	}
+
+	/// @brief Generate JSON text into a reused string for at least
+	/// min_seconds
+	template<typename T>
+	throughput_result bench_json( double min_seconds ) {
+		auto result = throughput_result{ };
+		auto gen = daw::data_gen::data_generator<T>( bench_seed );
+		auto out = std::string( );
+		daw::bench::reset_allocation_peak( );
+		auto const before = daw::bench::allocation_snapshot_now( );
+		auto const start = bench_clock::now( );
+		do {
+			out.clear( );
+			gen.generate_json( out );
+			daw::do_not_optimize( out );
+			result.json_bytes += out.size( );
+			++result.docs;
+			result.seconds =
+			  std::chrono::duration<double>( bench_clock::now( ) - start ).count( );
+		} while( result.seconds < min_seconds );
+		auto const after = daw::bench::allocation_snapshot_now( );
+		result.allocations = after.allocations - before.allocations;
+		result.peak_heap_bytes = after.peak_bytes - before.live_bytes;
+		return result;
+	}
+
+	template<typename T>
+	void bench_schema( char const *name, double min_seconds ) {
+		print_result( name, "value", bench_values<T>( min_seconds ) );
+		print_result( name, "json", bench_json<T>( min_seconds ) );
+	}
+} // namespace
+
+int main( int argc, char **argv ) {
+	double min_seconds = 1.0;
+	if( argc > 1 ) {
+		min_seconds = std::strtod( argv[1], nullptr );
+		if( not( min_seconds > 0.0 ) ) {
+			std::printf( "Usage: %s [seconds per measurement]\n", argv[0] );
+			return 1;
+		}
+	}
+	// Peak RSS covers the whole process so far, the schemas run smallest
+	// first
+	bench_schema<Foo>( "Foo", min_seconds );
+	bench_schema<Bar>( "Bar", min_seconds );
+	bench_schema<daw::geojson::FeatureCollection>( "geojson", min_seconds );
+	bench_schema<daw::twitter::twitter_object_t>( "twitter", min_seconds );
+	bench_schema<daw::citm::citm_object_t>( "citm", min_seconds );
+	return 0;
+}
@@ -184,7 +184,7 @@ namespace daw::data_gen::concepts {
 		static constexpr void put( T &out, char c ) {
 			daw_json_ensure( not out.empty( ), daw::json::ErrorReason::OutputError );
 			*out.data( ) = static_cast<CharT>( c );
-			out.remove_prefix( 1 );
+			out = out.subspan( 1 );
 		}
 	};
 
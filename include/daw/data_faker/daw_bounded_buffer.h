@@ -0,0 +1,139 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_data_gen
+//
+
+#pragma once
+
+#include "concepts/daw_writable_output_fwd.h"
+
+#include <daw/daw_string_view.h>
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace daw::data_gen {
+	/// @brief A writable output over a caller owned buffer that never writes
+	/// past its end and never allocates.  A write that does not fit marks the
+	/// buffer overflowed, and it and all following writes are dropped until
+	/// the buffer is rewound to a checkpoint taken before the overflow.
+	/// Bytes can be reserved, e.g. for closing brackets, so that they always
+	/// fit later.
+	class bounded_buffer {
+		char *m_first = nullptr;
+		char *m_pos = nullptr;
+		char *m_last = nullptr;
+		std::size_t m_reserved = 0;
+		bool m_overflowed = false;
+
+	public:
+		constexpr bounded_buffer( char *first, std::size_t capacity )
+		  : m_first( first )
+		  , m_pos( first )
+		  , m_last( first + capacity ) {}
+
+		/// @brief Use the storage of a contiguous range of char, e.g.
+		/// std::array<char, N>, std::vector<char> or std::span<char>
+		template<typename Range,
+		         std::enable_if_t<
+		           std::is_same_v<decltype( std::declval<Range &>( ).data( ) ),
+		                          char *>,
+		           std::nullptr_t> = nullptr>
+		constexpr explicit bounded_buffer( Range &range )
+		  : bounded_buffer( range.data( ), range.size( ) ) {}
+
+		constexpr char *data( ) const {
+			return m_first;
+		}
+
+		/// @brief Number of bytes written
+		constexpr std::size_t size( ) const {
+			return static_cast<std::size_t>( m_pos - m_first );
+		}
+
+		constexpr std::size_t capacity( ) const {
+			return static_cast<std::size_t>( m_last - m_first );
+		}
+
+		/// @brief Bytes that can be written without touching the reserve
+		constexpr std::size_t available( ) const {
+			return static_cast<std::size_t>( m_last - m_pos ) - m_reserved;
+		}
+
+		constexpr bool overflowed( ) const {
+			return m_overflowed;
+		}
+
+		constexpr daw::string_view str( ) const {
+			return daw::string_view( m_first, size( ) );
+		}
+
+		/// @brief Position to rewind to if what follows does not fit
+		constexpr std::size_t checkpoint( ) const {
+			return size( );
+		}
+
+		/// @brief Discard everything written after checkpoint and clear the
+		/// overflow
+		constexpr void rewind( std::size_t checkpoint ) {
+			m_pos = m_first + checkpoint;
+			m_overflowed = false;
+		}
+
+		/// @brief Hold back count bytes for later writes, the buffer overflows
+		/// when they are not available
+		constexpr void reserve( std::size_t count ) {
+			if( count > available( ) ) {
+				m_overflowed = true;
+				return;
+			}
+			m_reserved += count;
+		}
+
+		/// @brief Return count reserved bytes, call before writing them
+		constexpr void release( std::size_t count ) {
+			m_reserved -= count < m_reserved ? count : m_reserved;
+		}
+
+		void write( daw::string_view sv ) {
+			if( m_overflowed or sv.size( ) > available( ) ) {
+				m_overflowed = true;
+				return;
+			}
+			if( not sv.empty( ) ) {
+				std::memcpy( m_pos, sv.data( ), sv.size( ) );
+				m_pos += sv.size( );
+			}
+		}
+
+		constexpr void put( char c ) {
+			if( m_overflowed or available( ) == 0 ) {
+				m_overflowed = true;
+				return;
+			}
+			*m_pos++ = c;
+		}
+	};
+
+	namespace concepts {
+		/// @brief Specialization for bounded_buffer
+		template<>
+		struct writable_output_trait<bounded_buffer> : std::true_type {
+			template<typename... StringViews>
+			static inline void write( bounded_buffer &out, StringViews... svs ) {
+				static_assert( sizeof...( StringViews ) > 0 );
+				( out.write( daw::string_view( std::data( svs ), std::size( svs ) ) ),
+				  ... );
+			}
+
+			static constexpr void put( bounded_buffer &out, char c ) {
+				out.put( c );
+			}
+		};
+	} // namespace concepts
+} // namespace daw::data_gen
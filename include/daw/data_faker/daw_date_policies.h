@@ -0,0 +1,65 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_data_gen
+//
+
+#pragma once
+
+#include "daw_distributions.h"
+
+#include <cstdint>
+
+/// Date policies choose generated timestamps, in milliseconds since
+/// 1970-01-01T00:00:00Z.  A policy is a literal type with a const call
+/// operator taking a random engine and the date_clock of the generation
+/// state, so it can be used as a static constexpr value.  Timestamps must be
+/// in the years 0 to 9999 to be written as ISO 8601.
+namespace daw::data_gen {
+	/// @brief The last timestamp generated by a monotonic_dates policy.  It is
+	/// part of the generation state, so a data_generator keeps it between
+	/// documents
+	struct date_clock {
+		std::int64_t last_ms = 0;
+		bool started = false;
+	};
+
+	/// @brief Uniformly distributed over [first_ms, last_ms].  The default is
+	/// the years 2000 to 2029
+	struct uniform_dates {
+		std::int64_t first_ms = 946'684'800'000;
+		std::int64_t last_ms = 1'893'455'999'999;
+
+		template<typename RandomEngine>
+		constexpr std::int64_t operator( )( RandomEngine &reng,
+		                                    date_clock & ) const {
+			return uniform_int<std::int64_t>{ first_ms, last_ms }( reng );
+		}
+	};
+
+	/// @brief Increasing timestamps, like those of an event stream.  The first
+	/// is start_ms and each one after is between min_step_ms and max_step_ms
+	/// later, uniformly distributed.  The clock is shared by every monotonic
+	/// member of a document, so timestamps are sorted in document order and,
+	/// with a data_generator, across documents
+	struct monotonic_dates {
+		std::int64_t start_ms = 1'577'836'800'000;
+		std::int64_t min_step_ms = 0;
+		std::int64_t max_step_ms = 1'000;
+
+		template<typename RandomEngine>
+		constexpr std::int64_t operator( )( RandomEngine &reng,
+		                                    date_clock &clock ) const {
+			if( not clock.started ) {
+				clock.started = true;
+				clock.last_ms = start_ms;
+			} else {
+				clock.last_ms +=
+				  uniform_int<std::int64_t>{ min_step_ms, max_step_ms }( reng );
+			}
+			return clock.last_ms;
+		}
+	};
+} // namespace daw::data_gen
@@ -0,0 +1,143 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_data_gen
+//
+
+#pragma once
+
+#include "daw_random_engines.h"
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/// Distributions with a specified algorithm.  The std distributions leave
+/// theirs to the standard library, so the same engine and seed give
+/// different values with libstdc++, libc++ and MSVC.  These give the same
+/// values everywhere, given the same engine state.
+namespace daw::data_gen {
+	namespace datagen_details {
+		constexpr unsigned floor_log2( std::uint64_t x ) {
+			unsigned result = 0;
+			while( x > 1U ) {
+				x >>= 1U;
+				++result;
+			}
+			return result;
+		}
+	} // namespace datagen_details
+
+	/// @brief A uniformly distributed 64bit word from any engine.  Engines whose
+	/// range is not all 64 bits are called until 64 bits are collected, the
+	/// first value in the highest bits, e.g. two calls for pcg32 as in
+	/// pcg32::fill.  Values above the largest power of two that fits the
+	/// engine's range are discarded
+	template<typename RandomEngine>
+	constexpr std::uint64_t gen_random_word( RandomEngine &reng ) {
+		using result_t = typename RandomEngine::result_type;
+		constexpr auto range = static_cast<std::uint64_t>(
+		  static_cast<result_t>( RandomEngine::max( ) - RandomEngine::min( ) ) );
+		auto const draw = [&] {
+			return static_cast<std::uint64_t>(
+			  static_cast<result_t>( reng( ) - RandomEngine::min( ) ) );
+		};
+		if constexpr( range == std::numeric_limits<std::uint64_t>::max( ) ) {
+			return draw( );
+		} else {
+			constexpr unsigned bits = datagen_details::floor_log2( range + 1U );
+			static_assert( bits > 0, "Engine range is too small" );
+			constexpr std::uint64_t limit = std::uint64_t{ 1 } << bits;
+			std::uint64_t result = 0;
+			for( unsigned filled = 0; filled < 64U; filled += bits ) {
+				auto value = draw( );
+				while( value >= limit ) {
+					value = draw( );
+				}
+				result = ( result << bits ) | value;
+			}
+			return result;
+		}
+	}
+
+	/// @brief Uniformly distributed over [0, range], with Lemire's nearly
+	/// divisionless method.  A multiply per value, a division only when the
+	/// low half of the product falls in the biased region
+	/// D. Lemire, "Fast Random Integer Generation in an Interval", 2019
+	template<typename RandomEngine>
+	constexpr std::uint64_t gen_bounded( RandomEngine &reng,
+	                                     std::uint64_t range ) {
+		if( range == std::numeric_limits<std::uint64_t>::max( ) ) {
+			return gen_random_word( reng );
+		}
+		auto const n = range + 1U;
+		auto product = datagen_details::mul128( gen_random_word( reng ), n );
+		if( product[0] < n ) {
+			auto const threshold = ( std::uint64_t{ 0 } - n ) % n;
+			while( product[0] < threshold ) {
+				product = datagen_details::mul128( gen_random_word( reng ), n );
+			}
+		}
+		return product[1];
+	}
+
+	/// @brief true or false with equal probability, from the top bit of a word
+	template<typename RandomEngine>
+	constexpr bool gen_random_bool( RandomEngine &reng ) {
+		return ( gen_random_word( reng ) >> 63U ) != 0;
+	}
+
+	/// @brief Uniformly distributed over [0, 1).  The top 24 or 53 bits of a
+	/// word, the mantissa size of Real, are scaled by an exact power of two, so
+	/// the value is exact and the same on every IEEE 754 platform
+	template<typename Real, typename RandomEngine>
+	constexpr Real gen_unit_real( RandomEngine &reng ) {
+		static_assert( std::is_floating_point_v<Real> );
+		if constexpr( std::is_same_v<Real, float> ) {
+			return static_cast<float>( gen_random_word( reng ) >> 40U ) *
+			       ( 1.0f / 16777216.0f );
+		} else {
+			return static_cast<Real>(
+			  static_cast<double>( gen_random_word( reng ) >> 11U ) *
+			  ( 1.0 / 9007199254740992.0 ) );
+		}
+	}
+
+	/// @brief Integers uniformly distributed over [a, b].  One word per value
+	/// except for the rare rejection, see gen_bounded
+	template<typename Integer>
+	struct uniform_int {
+		static_assert( std::is_integral_v<Integer> and
+		                 not std::is_same_v<Integer, bool>,
+		               "Use gen_random_bool for bool" );
+		Integer a = 0;
+		Integer b = std::numeric_limits<Integer>::max( );
+
+		template<typename RandomEngine>
+		constexpr Integer operator( )( RandomEngine &reng ) const {
+			using unsigned_t = std::make_unsigned_t<Integer>;
+			auto const range = static_cast<unsigned_t>(
+			  static_cast<unsigned_t>( b ) - static_cast<unsigned_t>( a ) );
+			return static_cast<Integer>( static_cast<unsigned_t>(
+			  static_cast<unsigned_t>( a ) +
+			  static_cast<unsigned_t>( gen_bounded( reng, range ) ) ) );
+		}
+	};
+
+	/// @brief Reals uniformly distributed over [a, b), as
+	/// a + ( b - a ) * gen_unit_real.  Bit stable when the compiler does not
+	/// contract the expression into a fused multiply add
+	template<typename Real>
+	struct uniform_real {
+		static_assert( std::is_floating_point_v<Real> );
+		Real a = 0;
+		Real b = 1;
+
+		template<typename RandomEngine>
+		constexpr Real operator( )( RandomEngine &reng ) const {
+			return a + ( b - a ) * gen_unit_real<Real>( reng );
+		}
+	};
+} // namespace daw::data_gen
@@ -0,0 +1,184 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_data_gen
+//
+
+#pragma once
+
+#include "daw_distributions.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/// Length policies choose the length of generated strings and containers.  A
+/// policy is a literal type with a const call operator taking a random engine
+/// and returning the length, so it can be used as a static constexpr value.
+namespace daw::data_gen {
+	/// @brief Always the same length
+	struct fixed_length {
+		std::size_t length = 0;
+
+		template<typename RandomEngine>
+		constexpr std::size_t operator( )( RandomEngine & ) const {
+			return length;
+		}
+	};
+
+	/// @brief Uniformly distributed over [min_length, max_length]
+	struct uniform_length {
+		std::size_t min_length = 0;
+		std::size_t max_length = 0;
+
+		template<typename RandomEngine>
+		std::size_t operator( )( RandomEngine &reng ) const {
+			auto dist = uniform_int<std::size_t>{ min_length, max_length };
+			return dist( reng );
+		}
+	};
+
+	/// @brief Geometrically distributed with the given mean, short lengths are
+	/// the most likely.  Sampled by inversion, the result is exact given the
+	/// same std::log, which IEEE 754 does not require to be correctly rounded
+	struct geometric_length {
+		double mean = 0.0;
+
+		template<typename RandomEngine>
+		std::size_t operator( )( RandomEngine &reng ) const {
+			if( mean <= 0.0 ) {
+				return 0;
+			}
+			// u in ( 0, 1 ], the probability of continuing is mean / ( mean + 1 )
+			auto const u = 1.0 - gen_unit_real<double>( reng );
+			auto const length =
+			  std::floor( std::log( u ) / std::log( mean / ( mean + 1.0 ) ) );
+			if( not( length < static_cast<double>(
+			                    std::numeric_limits<std::size_t>::max( ) ) ) ) {
+				return std::numeric_limits<std::size_t>::max( );
+			}
+			return static_cast<std::size_t>( length );
+		}
+	};
+
+	/// @brief Zipf distributed over [0, max_length], the probability of length
+	/// n is proportional to 1/( n + 1 )^exponent.  Like geometric_length the
+	/// result depends on the platform's std::log and std::exp
+	struct zipf_length {
+		std::size_t max_length = 0;
+		double exponent = 1.0;
+
+		/// Rejection-inversion sampling, W. Hormann and G. Derflinger, "Rejection
+		/// inversion to get ranks of Zipf distributed random numbers". Needs no
+		/// table, so the cost does not depend on max_length
+		template<typename RandomEngine>
+		std::size_t operator( )( RandomEngine &reng ) const {
+			if( max_length == 0 ) {
+				return 0;
+			}
+			auto const n = static_cast<double>( max_length ) + 1.0;
+			auto const h_integral_x1 = h_integral( 1.5 ) - 1.0;
+			auto const h_integral_n = h_integral( n + 0.5 );
+			auto const s = 2.0 - h_integral_inverse( h_integral( 2.5 ) - h( 2.0 ) );
+			while( true ) {
+				auto const u = h_integral_n + gen_unit_real<double>( reng ) *
+				                                ( h_integral_x1 - h_integral_n );
+				auto const x = h_integral_inverse( u );
+				auto k = std::floor( x + 0.5 );
+				if( k < 1.0 ) {
+					k = 1.0;
+				} else if( k > n ) {
+					k = n;
+				}
+				if( k - x <= s or u >= h_integral( k + 0.5 ) - h( k ) ) {
+					return static_cast<std::size_t>( k ) - 1U;
+				}
+			}
+		}
+
+	private:
+		// log1p( x ) / x, stable near 0
+		static double helper1( double x ) {
+			if( std::abs( x ) > 1e-8 ) {
+				return std::log1p( x ) / x;
+			}
+			return 1.0 - x * ( 0.5 - x * ( 1.0 / 3.0 - 0.25 * x ) );
+		}
+
+		// expm1( x ) / x, stable near 0
+		static double helper2( double x ) {
+			if( std::abs( x ) > 1e-8 ) {
+				return std::expm1( x ) / x;
+			}
+			return 1.0 + x * 0.5 * ( 1.0 + x * ( 1.0 / 3.0 ) * ( 1.0 + 0.25 * x ) );
+		}
+
+		double h( double x ) const {
+			return std::exp( -exponent * std::log( x ) );
+		}
+
+		double h_integral( double x ) const {
+			auto const log_x = std::log( x );
+			return helper2( ( 1.0 - exponent ) * log_x ) * log_x;
+		}
+
+		double h_integral_inverse( double x ) const {
+			auto t = x * ( 1.0 - exponent );
+			if( t < -1.0 ) {
+				t = -1.0;
+			}
+			return std::exp( helper1( t ) * x );
+		}
+	};
+
+	/// @brief One bucket of an empirical length histogram, lengths in
+	/// [min_length, max_length] are chosen with relative weight weight
+	struct histogram_bucket {
+		std::size_t min_length = 0;
+		std::size_t max_length = 0;
+		std::uint32_t weight = 1;
+	};
+
+	/// @brief Lengths follow an empirical histogram.  A bucket is chosen by
+	/// weight, then the length uniformly within it
+	/// e.g. histogram_length{ histogram_bucket{ 0, 0, 5 },
+	///                        histogram_bucket{ 1, 16, 90 },
+	///                        histogram_bucket{ 1000, 1000000, 5 } }
+	template<std::size_t BucketCount>
+	struct histogram_length {
+		static_assert( BucketCount > 0, "A histogram needs at least one bucket" );
+		std::array<histogram_bucket, BucketCount> buckets;
+
+		template<typename... Buckets>
+		constexpr histogram_length( Buckets const &...bs )
+		  : buckets{ bs... } {}
+
+		template<typename RandomEngine>
+		std::size_t operator( )( RandomEngine &reng ) const {
+			std::uint64_t total_weight = 0;
+			for( auto const &b : buckets ) {
+				total_weight += b.weight;
+			}
+			if( total_weight == 0 ) {
+				return 0;
+			}
+			auto r = gen_bounded( reng, total_weight - 1U );
+			for( auto const &b : buckets ) {
+				if( r < b.weight ) {
+					return uniform_length{ b.min_length, b.max_length }( reng );
+				}
+				r -= b.weight;
+			}
+			// Unreachable, r < total_weight
+			return buckets.back( ).max_length;
+		}
+	};
+
+	template<typename... Buckets>
+	histogram_length( Buckets const &... )
+	  -> histogram_length<sizeof...( Buckets )>;
+} // namespace daw::data_gen
@@ -0,0 +1,212 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_data_gen
+//
+
+#pragma once
+
+#include "daw_distributions.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+/// Number profiles choose the shape of generated numbers, e.g. how many
+/// digits or how large an exponent they are written with.  A profile is a
+/// literal type with a const call operator taking a random engine and
+/// returning the number, so it can be used as a static constexpr value.
+/// uniform_int and uniform_real are profiles too.  All are built from
+/// correctly rounded IEEE 754 operations, so a seed gives the same numbers
+/// everywhere.
+namespace daw::data_gen {
+	namespace datagen_details {
+		/// @brief 10^exponent, by squaring.  Each multiply is correctly rounded,
+		/// so the result is the same everywhere, and exact up to 10^22
+		template<typename Real>
+		constexpr Real pow10( unsigned exponent ) {
+			Real result = 1;
+			Real base = 10;
+			while( exponent > 0 ) {
+				if( exponent & 1U ) {
+					result *= base;
+				}
+				exponent >>= 1U;
+				if( exponent > 0 ) {
+					base *= base;
+				}
+			}
+			return result;
+		}
+
+		constexpr std::uint64_t pow10_u64( unsigned exponent ) {
+			std::uint64_t result = 1;
+			while( exponent-- > 0 ) {
+				result *= 10U;
+			}
+			return result;
+		}
+
+		template<typename Real, typename RandomEngine>
+		constexpr Real with_random_sign( RandomEngine &reng, Real value ) {
+			return gen_random_bool( reng ) ? -value : value;
+		}
+	} // namespace datagen_details
+
+	/// @brief Integers uniformly distributed over the whole range of Integer.
+	/// Most have the largest number of digits
+	template<typename Integer>
+	struct full_range_ints {
+		template<typename RandomEngine>
+		constexpr Integer operator( )( RandomEngine &reng ) const {
+			if constexpr( std::is_signed_v<Integer> ) {
+				return uniform_int<Integer>{ std::numeric_limits<Integer>::min( ),
+				                             std::numeric_limits<Integer>::max( ) }(
+				  reng );
+			} else {
+				return uniform_int<Integer>{ 0, std::numeric_limits<Integer>::max( ) }(
+				  reng );
+			}
+		}
+	};
+
+	/// @brief Integers whose number of decimal digits is uniformly distributed
+	/// over [min_digits, max_digits], then uniformly distributed among those
+	/// with that many.  Signed integers are negative half the time
+	template<typename Integer>
+	struct digit_count_ints {
+		static constexpr unsigned max_digits_of_type =
+		  static_cast<unsigned>( std::numeric_limits<Integer>::digits10 );
+
+		unsigned min_digits = 1;
+		unsigned max_digits = max_digits_of_type;
+
+		template<typename RandomEngine>
+		constexpr Integer operator( )( RandomEngine &reng ) const {
+			auto const hi =
+			  max_digits < max_digits_of_type ? max_digits : max_digits_of_type;
+			auto const lo =
+			  min_digits < 1U ? 1U : ( min_digits < hi ? min_digits : hi );
+			auto const digits =
+			  static_cast<unsigned>( lo + gen_bounded( reng, hi - lo ) );
+			auto const first =
+			  digits == 1U ? 0U : datagen_details::pow10_u64( digits - 1U );
+			auto const last = datagen_details::pow10_u64( digits ) - 1U;
+			auto const value =
+			  static_cast<Integer>( first + gen_bounded( reng, last - first ) );
+			if constexpr( std::is_signed_v<Integer> ) {
+				return gen_random_bool( reng ) ? static_cast<Integer>( -value ) : value;
+			} else {
+				return value;
+			}
+		}
+	};
+
+	/// @brief Reals uniformly distributed over ( -1, 1 ), with as many digits
+	/// as it takes to round trip
+	template<typename Real>
+	struct unit_reals {
+		template<typename RandomEngine>
+		constexpr Real operator( )( RandomEngine &reng ) const {
+			auto const result = gen_unit_real<Real>( reng );
+			return datagen_details::with_random_sign( reng, result );
+		}
+	};
+
+	/// @brief Reals written with an exponent, a mantissa uniformly distributed
+	/// over [1, 10) times 10 to an exponent uniformly distributed over
+	/// [min_exponent, max_exponent].  Exponents are limited to those of Real
+	/// that do not overflow
+	template<typename Real>
+	struct exponent_reals {
+		static constexpr int largest_exponent =
+		  std::numeric_limits<Real>::max_exponent10 - 1;
+		static constexpr int smallest_exponent =
+		  std::numeric_limits<Real>::min_exponent10;
+
+		int min_exponent = smallest_exponent;
+		int max_exponent = largest_exponent;
+
+		template<typename RandomEngine>
+		constexpr Real operator( )( RandomEngine &reng ) const {
+			auto const lo =
+			  min_exponent < smallest_exponent ? smallest_exponent : min_exponent;
+			auto const hi =
+			  max_exponent > largest_exponent ? largest_exponent : max_exponent;
+			auto const exponent = hi < lo ? lo : uniform_int<int>{ lo, hi }( reng );
+			auto const mantissa = 1 + 9 * gen_unit_real<Real>( reng );
+			auto const value =
+			  exponent < 0
+			    ? mantissa / datagen_details::pow10<Real>(
+			                   static_cast<unsigned>( -exponent ) )
+			    : mantissa * datagen_details::pow10<Real>(
+			                   static_cast<unsigned>( exponent ) );
+			return datagen_details::with_random_sign( reng, value );
+		}
+	};
+
+	/// @brief Subnormal reals, those smaller than
+	/// std::numeric_limits<Real>::min( ) that parsers often handle on a slow
+	/// path.  The significand bits are uniformly distributed
+	template<typename Real>
+	struct subnormal_reals {
+		static_assert( std::numeric_limits<Real>::is_iec559 and
+		                 ( sizeof( Real ) == 4 or sizeof( Real ) == 8 ),
+		               "Only IEEE 754 float and double are supported" );
+
+		template<typename RandomEngine>
+		Real operator( )( RandomEngine &reng ) const {
+			constexpr unsigned significand_bits =
+			  static_cast<unsigned>( std::numeric_limits<Real>::digits ) - 1U;
+			constexpr std::uint64_t significand_mask =
+			  ( std::uint64_t{ 1 } << significand_bits ) - 1U;
+			auto const significand =
+			  1U + gen_bounded( reng, significand_mask - 1U );
+			auto result = Real{ };
+			if constexpr( sizeof( Real ) == 4 ) {
+				auto const bits = static_cast<std::uint32_t>( significand );
+				std::memcpy( &result, &bits, sizeof( result ) );
+			} else {
+				std::memcpy( &result, &significand, sizeof( result ) );
+			}
+			return datagen_details::with_random_sign( reng, result );
+		}
+	};
+
+	/// @brief Whole numbers stored as reals, e.g. counts in a schema that
+	/// only has doubles.  Uniformly distributed over [min_value, max_value]
+	template<typename Real>
+	struct integral_reals {
+		std::int64_t min_value = -1'000'000;
+		std::int64_t max_value = 1'000'000;
+
+		template<typename RandomEngine>
+		constexpr Real operator( )( RandomEngine &reng ) const {
+			return static_cast<Real>(
+			  uniform_int<std::int64_t>{ min_value, max_value }( reng ) );
+		}
+	};
+
+	/// @brief Reals with fraction_digits decimal places, e.g. prices.
+	/// min_units and max_units count in steps of 10^-fraction_digits, so
+	/// { 0, 100'000, 2 } is 0.00 to 1000.00.  While the units are exact in
+	/// Real the value is the closest Real to the decimal, so it is written with
+	/// at most fraction_digits places.  fraction_digits is limited to 22
+	template<typename Real>
+	struct decimal_reals {
+		std::int64_t min_units = 0;
+		std::int64_t max_units = 100'000;
+		unsigned fraction_digits = 2;
+
+		template<typename RandomEngine>
+		constexpr Real operator( )( RandomEngine &reng ) const {
+			auto const units = static_cast<Real>(
+			  uniform_int<std::int64_t>{ min_units, max_units }( reng ) );
+			return units / datagen_details::pow10<Real>(
+			                 fraction_digits < 22U ? fraction_digits : 22U );
+		}
+	};
+} // namespace daw::data_gen
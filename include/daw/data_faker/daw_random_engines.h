@@ -0,0 +1,486 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_data_gen
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/// Random engines that are faster than the std ones and give the same
+/// sequence on every platform.  All model UniformRandomBitGenerator, so they
+/// work with the std distributions, and have a bulk
+/// fill( first, last ) that writes the same values as calling the engine
+/// last - first times.  The generators use fill when an engine has it.
+namespace daw::data_gen {
+	namespace datagen_details {
+		constexpr std::uint64_t splitmix64_mix( std::uint64_t z ) {
+			z = ( z ^ ( z >> 30U ) ) * 0xBF58'476D'1CE4'E5B9ULL;
+			z = ( z ^ ( z >> 27U ) ) * 0x94D0'49BB'1331'11EBULL;
+			return z ^ ( z >> 31U );
+		}
+
+		constexpr std::uint64_t rotl( std::uint64_t x, unsigned k ) {
+			return ( x << k ) | ( x >> ( ( 64U - k ) & 63U ) );
+		}
+
+		constexpr std::uint32_t rotr32( std::uint32_t x, unsigned k ) {
+			return ( x >> k ) | ( x << ( ( 32U - k ) & 31U ) );
+		}
+
+		/// @brief The 128bit product of a and b as { low, high }
+		constexpr std::array<std::uint64_t, 2> mul128( std::uint64_t a,
+		                                               std::uint64_t b ) {
+#if defined( __SIZEOF_INT128__ )
+			auto const r = static_cast<unsigned __int128>( a ) * b;
+			return { static_cast<std::uint64_t>( r ),
+			         static_cast<std::uint64_t>( r >> 64U ) };
+#else
+			auto const a_lo = a & 0xFFFF'FFFFULL;
+			auto const a_hi = a >> 32U;
+			auto const b_lo = b & 0xFFFF'FFFFULL;
+			auto const b_hi = b >> 32U;
+			auto const lo_lo = a_lo * b_lo;
+			auto const hi_lo = a_hi * b_lo;
+			auto const lo_hi = a_lo * b_hi;
+			auto const hi_hi = a_hi * b_hi;
+			auto const cross =
+			  ( lo_lo >> 32U ) + ( hi_lo & 0xFFFF'FFFFULL ) + lo_hi;
+			return { ( cross << 32U ) | ( lo_lo & 0xFFFF'FFFFULL ),
+			         ( hi_lo >> 32U ) + ( cross >> 32U ) + hi_hi };
+#endif
+		}
+	} // namespace datagen_details
+
+	/// @brief SplitMix64, used to expand a 64bit seed into the state of the
+	/// other engines.  Every seed, including 0, is a good one
+	class splitmix64 {
+		std::uint64_t m_state = 0;
+
+	public:
+		using result_type = std::uint64_t;
+		static constexpr std::uint64_t default_seed = 0;
+
+		constexpr splitmix64( ) = default;
+		constexpr explicit splitmix64( std::uint64_t s )
+		  : m_state( s ) {}
+
+		static constexpr result_type min( ) {
+			return 0;
+		}
+
+		static constexpr result_type max( ) {
+			return std::numeric_limits<result_type>::max( );
+		}
+
+		constexpr void seed( std::uint64_t s ) {
+			m_state = s;
+		}
+
+		constexpr result_type operator( )( ) {
+			m_state += 0x9E37'79B9'7F4A'7C15ULL;
+			return datagen_details::splitmix64_mix( m_state );
+		}
+
+		constexpr void fill( std::uint64_t *first, std::uint64_t *last ) {
+			auto s = m_state;
+			for( ; first != last; ++first ) {
+				s += 0x9E37'79B9'7F4A'7C15ULL;
+				*first = datagen_details::splitmix64_mix( s );
+			}
+			m_state = s;
+		}
+
+		constexpr void discard( unsigned long long count ) {
+			m_state += 0x9E37'79B9'7F4A'7C15ULL * count;
+		}
+
+		friend constexpr bool operator==( splitmix64 const &lhs,
+		                                  splitmix64 const &rhs ) {
+			return lhs.m_state == rhs.m_state;
+		}
+
+		friend constexpr bool operator!=( splitmix64 const &lhs,
+		                                  splitmix64 const &rhs ) {
+			return lhs.m_state != rhs.m_state;
+		}
+	};
+
+	/// @brief xoshiro256** by D. Blackman and S. Vigna, a fast all purpose
+	/// engine with a period of 2^256 - 1.  jump( ) advances it by 2^128 calls,
+	/// giving non overlapping sequences for parallel use
+	class xoshiro256ss {
+		std::array<std::uint64_t, 4> m_state{ };
+
+		constexpr void advance_by( std::array<std::uint64_t, 4> const &poly ) {
+			std::array<std::uint64_t, 4> result{ };
+			for( auto word : poly ) {
+				for( unsigned b = 0; b < 64U; ++b ) {
+					if( ( word >> b ) & 1U ) {
+						for( std::size_t n = 0; n < 4; ++n ) {
+							result[n] ^= m_state[n];
+						}
+					}
+					operator( )( );
+				}
+			}
+			m_state = result;
+		}
+
+	public:
+		using result_type = std::uint64_t;
+		static constexpr std::uint64_t default_seed = 0x853C'49E6'748F'EA9BULL;
+
+		constexpr xoshiro256ss( )
+		  : xoshiro256ss( default_seed ) {}
+
+		constexpr explicit xoshiro256ss( std::uint64_t s ) {
+			seed( s );
+		}
+
+		/// @brief Use state as is, it must not be all zero
+		constexpr explicit xoshiro256ss(
+		  std::array<std::uint64_t, 4> const &state )
+		  : m_state( state ) {}
+
+		static constexpr result_type min( ) {
+			return 0;
+		}
+
+		static constexpr result_type max( ) {
+			return std::numeric_limits<result_type>::max( );
+		}
+
+		constexpr void seed( std::uint64_t s ) {
+			auto sm = splitmix64( s );
+			for( auto &word : m_state ) {
+				word = sm( );
+			}
+		}
+
+		constexpr result_type operator( )( ) {
+			auto const result = datagen_details::rotl( m_state[1] * 5U, 7U ) * 9U;
+			auto const t = m_state[1] << 17U;
+			m_state[2] ^= m_state[0];
+			m_state[3] ^= m_state[1];
+			m_state[1] ^= m_state[2];
+			m_state[0] ^= m_state[3];
+			m_state[2] ^= t;
+			m_state[3] = datagen_details::rotl( m_state[3], 45U );
+			return result;
+		}
+
+		constexpr void fill( std::uint64_t *first, std::uint64_t *last ) {
+			auto s0 = m_state[0];
+			auto s1 = m_state[1];
+			auto s2 = m_state[2];
+			auto s3 = m_state[3];
+			for( ; first != last; ++first ) {
+				*first = datagen_details::rotl( s1 * 5U, 7U ) * 9U;
+				auto const t = s1 << 17U;
+				s2 ^= s0;
+				s3 ^= s1;
+				s1 ^= s2;
+				s0 ^= s3;
+				s2 ^= t;
+				s3 = datagen_details::rotl( s3, 45U );
+			}
+			m_state = { s0, s1, s2, s3 };
+		}
+
+		constexpr void discard( unsigned long long count ) {
+			while( count-- > 0 ) {
+				operator( )( );
+			}
+		}
+
+		/// @brief Advance by 2^128 calls
+		constexpr void jump( ) {
+			advance_by( { 0x180E'C6D3'3CFD'0ABAULL, 0xD5A6'1266'F0C9'392CULL,
+			              0xA958'2618'E03F'C9AAULL, 0x39AB'DC45'29B1'661CULL } );
+		}
+
+		/// @brief Advance by 2^192 calls
+		constexpr void long_jump( ) {
+			advance_by( { 0x76E1'5D3E'FEFD'CBBFULL, 0xC500'4E44'1C52'2FB3ULL,
+			              0x7771'0069'854E'E241ULL, 0x3910'9BB0'2ACB'E635ULL } );
+		}
+
+		friend bool operator==( xoshiro256ss const &lhs,
+		                        xoshiro256ss const &rhs ) {
+			return lhs.m_state == rhs.m_state;
+		}
+
+		friend bool operator!=( xoshiro256ss const &lhs,
+		                        xoshiro256ss const &rhs ) {
+			return not( lhs == rhs );
+		}
+	};
+
+	/// @brief wyrand by Wang Yi, one add and one 128bit multiply per value.
+	/// The fastest engine here, with a period of 2^64
+	class wyrand {
+		std::uint64_t m_state = 0;
+
+		static constexpr std::uint64_t next( std::uint64_t &state ) {
+			state += 0xA076'1D64'78BD'642FULL;
+			auto const r =
+			  datagen_details::mul128( state, state ^ 0xE703'7ED1'A0B4'28DBULL );
+			return r[0] ^ r[1];
+		}
+
+	public:
+		using result_type = std::uint64_t;
+		static constexpr std::uint64_t default_seed = 0;
+
+		constexpr wyrand( ) = default;
+		constexpr explicit wyrand( std::uint64_t s )
+		  : m_state( s ) {}
+
+		static constexpr result_type min( ) {
+			return 0;
+		}
+
+		static constexpr result_type max( ) {
+			return std::numeric_limits<result_type>::max( );
+		}
+
+		constexpr void seed( std::uint64_t s ) {
+			m_state = s;
+		}
+
+		constexpr result_type operator( )( ) {
+			return next( m_state );
+		}
+
+		constexpr void fill( std::uint64_t *first, std::uint64_t *last ) {
+			auto s = m_state;
+			for( ; first != last; ++first ) {
+				*first = next( s );
+			}
+			m_state = s;
+		}
+
+		constexpr void discard( unsigned long long count ) {
+			m_state += 0xA076'1D64'78BD'642FULL * count;
+		}
+
+		friend constexpr bool operator==( wyrand const &lhs, wyrand const &rhs ) {
+			return lhs.m_state == rhs.m_state;
+		}
+
+		friend constexpr bool operator!=( wyrand const &lhs, wyrand const &rhs ) {
+			return lhs.m_state != rhs.m_state;
+		}
+	};
+
+	/// @brief PCG32 (XSH RR 64/32) by M. O'Neill.  Produces 32bit values,
+	/// fill packs two per 64bit word, the first in the high half.  The stream
+	/// selects one of 2^63 independent sequences
+	class pcg32 {
+		std::uint64_t m_state = 0;
+		std::uint64_t m_inc = 0;
+
+		static constexpr std::uint64_t multiplier = 6364136223846793005ULL;
+
+	public:
+		using result_type = std::uint32_t;
+		static constexpr std::uint64_t default_seed = 0x853C'49E6'748F'EA9BULL;
+		static constexpr std::uint64_t default_stream = 0xDA3E'39CB'94B9'5BDBULL;
+
+		constexpr pcg32( )
+		  : pcg32( default_seed ) {}
+
+		constexpr explicit pcg32( std::uint64_t s,
+		                          std::uint64_t stream = default_stream ) {
+			seed( s, stream );
+		}
+
+		static constexpr result_type min( ) {
+			return 0;
+		}
+
+		static constexpr result_type max( ) {
+			return std::numeric_limits<result_type>::max( );
+		}
+
+		constexpr void seed( std::uint64_t s,
+		                     std::uint64_t stream = default_stream ) {
+			m_state = 0;
+			m_inc = ( stream << 1U ) | 1U;
+			operator( )( );
+			m_state += s;
+			operator( )( );
+		}
+
+		constexpr result_type operator( )( ) {
+			auto const old = m_state;
+			m_state = old * multiplier + m_inc;
+			auto const xorshifted =
+			  static_cast<std::uint32_t>( ( ( old >> 18U ) ^ old ) >> 27U );
+			return datagen_details::rotr32(
+			  xorshifted, static_cast<unsigned>( old >> 59U ) );
+		}
+
+		constexpr void fill( std::uint64_t *first, std::uint64_t *last ) {
+			for( ; first != last; ++first ) {
+				auto const hi = static_cast<std::uint64_t>( operator( )( ) );
+				*first = ( hi << 32U ) | operator( )( );
+			}
+		}
+
+		constexpr void discard( unsigned long long count ) {
+			while( count-- > 0 ) {
+				operator( )( );
+			}
+		}
+
+		friend constexpr bool operator==( pcg32 const &lhs, pcg32 const &rhs ) {
+			return lhs.m_state == rhs.m_state and lhs.m_inc == rhs.m_inc;
+		}
+
+		friend constexpr bool operator!=( pcg32 const &lhs, pcg32 const &rhs ) {
+			return not( lhs == rhs );
+		}
+	};
+
+	/// @brief Philox4x32-10 by J. Salmon et al., a counter based engine.  The
+	/// value at any position is computed directly from the key and the
+	/// counter, so set_counter( n ) jumps to the n'th block of 128 bits in
+	/// constant time.  Each key is an independent sequence of 2^130 bits
+	class philox4x32 {
+		std::array<std::uint32_t, 2> m_key{ };
+		std::array<std::uint32_t, 4> m_counter{ };
+		std::array<std::uint64_t, 2> m_buffer{ };
+		std::size_t m_buffer_pos = 2;
+
+		constexpr void increment_counter( ) {
+			for( auto &word : m_counter ) {
+				if( ++word != 0 ) {
+					return;
+				}
+			}
+		}
+
+		constexpr void refill( ) {
+			auto const block = generate_block( m_key, m_counter );
+			m_buffer[0] = ( static_cast<std::uint64_t>( block[0] ) << 32U ) |
+			              block[1];
+			m_buffer[1] = ( static_cast<std::uint64_t>( block[2] ) << 32U ) |
+			              block[3];
+			increment_counter( );
+			m_buffer_pos = 0;
+		}
+
+	public:
+		using result_type = std::uint64_t;
+		static constexpr std::uint64_t default_seed = 0;
+
+		constexpr philox4x32( )
+		  : philox4x32( default_seed ) {}
+
+		constexpr explicit philox4x32( std::uint64_t s ) {
+			seed( s );
+		}
+
+		static constexpr result_type min( ) {
+			return 0;
+		}
+
+		static constexpr result_type max( ) {
+			return std::numeric_limits<result_type>::max( );
+		}
+
+		/// @brief The 10 round Philox4x32 bijection of counter under key
+		static constexpr std::array<std::uint32_t, 4>
+		generate_block( std::array<std::uint32_t, 2> key,
+		                std::array<std::uint32_t, 4> ctr ) {
+			for( int round = 0; round < 10; ++round ) {
+				if( round > 0 ) {
+					key[0] += 0x9E37'79B9U;
+					key[1] += 0xBB67'AE85U;
+				}
+				auto const p0 = std::uint64_t{ 0xD251'1F53U } * ctr[0];
+				auto const p1 = std::uint64_t{ 0xCD9E'8D57U } * ctr[2];
+				ctr = { static_cast<std::uint32_t>( p1 >> 32U ) ^ ctr[1] ^ key[0],
+				        static_cast<std::uint32_t>( p1 ),
+				        static_cast<std::uint32_t>( p0 >> 32U ) ^ ctr[3] ^ key[1],
+				        static_cast<std::uint32_t>( p0 ) };
+			}
+			return ctr;
+		}
+
+		/// @brief Use s as the key and start at counter 0
+		constexpr void seed( std::uint64_t s ) {
+			m_key = { static_cast<std::uint32_t>( s ),
+			          static_cast<std::uint32_t>( s >> 32U ) };
+			set_counter( 0 );
+		}
+
+		/// @brief Continue from the block at position n
+		constexpr void set_counter( std::uint64_t n ) {
+			m_counter = { static_cast<std::uint32_t>( n ),
+			              static_cast<std::uint32_t>( n >> 32U ), 0, 0 };
+			m_buffer_pos = 2;
+		}
+
+		constexpr result_type operator( )( ) {
+			if( m_buffer_pos == 2 ) {
+				refill( );
+			}
+			return m_buffer[m_buffer_pos++];
+		}
+
+		constexpr void fill( std::uint64_t *first, std::uint64_t *last ) {
+			while( first != last and m_buffer_pos != 2 ) {
+				*first++ = m_buffer[m_buffer_pos++];
+			}
+			// Whole blocks straight to the output
+			for( ; last - first >= 2; first += 2 ) {
+				auto const block = generate_block( m_key, m_counter );
+				first[0] = ( static_cast<std::uint64_t>( block[0] ) << 32U ) |
+				           block[1];
+				first[1] = ( static_cast<std::uint64_t>( block[2] ) << 32U ) |
+				           block[3];
+				increment_counter( );
+			}
+			if( first != last ) {
+				*first = operator( )( );
+			}
+		}
+
+		constexpr void discard( unsigned long long count ) {
+			while( count > 0 and m_buffer_pos != 2 ) {
+				++m_buffer_pos;
+				--count;
+			}
+			for( ; count >= 2; count -= 2 ) {
+				increment_counter( );
+			}
+			if( count > 0 ) {
+				operator( )( );
+			}
+		}
+
+		friend bool operator==( philox4x32 const &lhs,
+		                        philox4x32 const &rhs ) {
+			return lhs.m_key == rhs.m_key and lhs.m_counter == rhs.m_counter and
+			       lhs.m_buffer_pos == rhs.m_buffer_pos and
+			       ( lhs.m_buffer_pos == 2 or lhs.m_buffer == rhs.m_buffer );
+		}
+
+		friend bool operator!=( philox4x32 const &lhs,
+		                        philox4x32 const &rhs ) {
+			return not( lhs == rhs );
+		}
+	};
+
+	/// @brief The engine used when none is given
+	using default_random_engine = xoshiro256ss;
+} // namespace daw::data_gen
@@ -0,0 +1,206 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_data_gen
+//
+
+#pragma once
+
+#include "daw_distributions.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/// Text generators write the text of a random value, e.g. a timestamp or a
+/// decimal, into a caller's buffer.  A text generator is a literal type with
+/// a static constexpr max_size and a const call operator taking a random
+/// engine and a char * with room for max_size characters, returning the end
+/// of the text written.  Nothing is allocated.
+namespace daw::data_gen {
+	namespace datagen_details {
+		/// @brief Write value as exactly width decimal digits, zero padded.
+		/// Higher digits of value are dropped
+		constexpr char *write_fixed_digits( char *out, std::uint64_t value,
+		                                    std::size_t width ) {
+			for( std::size_t n = width; n > 0; --n ) {
+				out[n - 1U] = static_cast<char>( '0' + value % 10U );
+				value /= 10U;
+			}
+			return out + width;
+		}
+
+		struct civil_date {
+			std::int64_t year = 1970;
+			unsigned month = 1;
+			unsigned day = 1;
+		};
+
+		/// @brief The proleptic Gregorian date days after 1970-01-01
+		/// H. Hinnant, "chrono-Compatible Low-Level Date Algorithms"
+		constexpr civil_date civil_from_days( std::int64_t days ) {
+			days += 719468;
+			auto const era = ( days >= 0 ? days : days - 146096 ) / 146097;
+			auto const doe = static_cast<std::uint64_t>( days - era * 146097 );
+			auto const yoe =
+			  ( doe - doe / 1460U + doe / 36524U - doe / 146096U ) / 365U;
+			auto const doy = doe - ( 365U * yoe + yoe / 4U - yoe / 100U );
+			auto const mp = ( 5U * doy + 2U ) / 153U;
+			auto const day = static_cast<unsigned>( doy - ( 153U * mp + 2U ) / 5U +
+			                                        1U );
+			auto const month = static_cast<unsigned>( mp < 10U ? mp + 3U : mp - 9U );
+			auto const year = static_cast<std::int64_t>( yoe ) + era * 400 +
+			                  ( month <= 2U ? 1 : 0 );
+			return civil_date{ year, month, day };
+		}
+
+		constexpr std::int64_t floor_div( std::int64_t x, std::int64_t y ) {
+			auto const q = x / y;
+			return ( x % y != 0 and ( ( x < 0 ) != ( y < 0 ) ) ) ? q - 1 : q;
+		}
+
+		/// @brief Write seconds since 1970-01-01T00:00:00Z, plus millis, as
+		/// an ISO 8601 UTC timestamp, e.g. 2021-03-04T05:06:07.089Z.  Only the
+		/// leading fraction_digits, at most 3, of millis are written.  The
+		/// year must be in [0, 9999]
+		constexpr char *write_iso8601( char *out, std::int64_t seconds,
+		                               unsigned fraction_digits,
+		                               unsigned millis ) {
+			auto const days = floor_div( seconds, 86400 );
+			auto const secs_of_day =
+			  static_cast<std::uint64_t>( seconds - days * 86400 );
+			auto const date = civil_from_days( days );
+			out = write_fixed_digits( out, static_cast<std::uint64_t>( date.year ),
+			                          4 );
+			*out++ = '-';
+			out = write_fixed_digits( out, date.month, 2 );
+			*out++ = '-';
+			out = write_fixed_digits( out, date.day, 2 );
+			*out++ = 'T';
+			out = write_fixed_digits( out, secs_of_day / 3600U, 2 );
+			*out++ = ':';
+			out = write_fixed_digits( out, secs_of_day / 60U % 60U, 2 );
+			*out++ = ':';
+			out = write_fixed_digits( out, secs_of_day % 60U, 2 );
+			if( fraction_digits > 0 ) {
+				*out++ = '.';
+				for( auto n = fraction_digits; n < 3U; ++n ) {
+					millis /= 10U;
+				}
+				out = write_fixed_digits( out, millis, fraction_digits );
+			}
+			*out++ = 'Z';
+			return out;
+		}
+	} // namespace datagen_details
+
+	/// @brief Decimal integers uniformly distributed over [a, b], e.g. ids
+	/// stored as strings
+	template<typename Integer>
+	struct integer_text {
+		static_assert( std::is_integral_v<Integer> and
+		               not std::is_same_v<Integer, bool> );
+		static constexpr std::size_t max_size =
+		  static_cast<std::size_t>( std::numeric_limits<Integer>::digits10 ) + 2U;
+
+		Integer a = 0;
+		Integer b = std::numeric_limits<Integer>::max( );
+
+		template<typename RandomEngine>
+		char *operator( )( RandomEngine &reng, char *out ) const {
+			auto const value = uniform_int<Integer>{ a, b }( reng );
+			return std::to_chars( out, out + max_size, value ).ptr;
+		}
+	};
+
+	/// @brief Fixed point decimals, an integer part uniformly distributed over
+	/// [min_integer, max_integer] followed by fraction_digits random digits,
+	/// e.g. prices as "1234.56".  fraction_digits is limited to 18
+	struct decimal_text {
+		static constexpr std::size_t max_fraction_digits = 18U;
+		static constexpr std::size_t max_size =
+		  static_cast<std::size_t>(
+		    std::numeric_limits<std::int64_t>::digits10 ) +
+		  3U + max_fraction_digits;
+
+		std::int64_t min_integer = 0;
+		std::int64_t max_integer = 999'999;
+		std::size_t fraction_digits = 2;
+
+		template<typename RandomEngine>
+		char *operator( )( RandomEngine &reng, char *out ) const {
+			auto const integer =
+			  uniform_int<std::int64_t>{ min_integer, max_integer }( reng );
+			out = std::to_chars( out, out + max_size, integer ).ptr;
+			auto const digits = std::min( fraction_digits, max_fraction_digits );
+			if( digits > 0 ) {
+				*out++ = '.';
+				// The low digits of a uniform 18 digit number are uniform too
+				out = datagen_details::write_fixed_digits(
+				  out, gen_bounded( reng, 999'999'999'999'999'999ULL ), digits );
+			}
+			return out;
+		}
+	};
+
+	/// @brief ISO 8601 UTC timestamps uniformly distributed over
+	/// [first_second, last_second], in seconds since 1970-01-01T00:00:00Z, e.g.
+	/// 2021-03-04T05:06:07Z.  The default range is the years 2000 to 2029.
+	/// Both must be in the years 0 to 9999
+	struct iso8601_text {
+		static constexpr std::size_t max_size = 24U;
+
+		std::int64_t first_second = 946'684'800;
+		std::int64_t last_second = 1'893'455'999;
+		/// Add milliseconds, e.g. 2021-03-04T05:06:07.089Z
+		bool with_millis = false;
+
+		template<typename RandomEngine>
+		char *operator( )( RandomEngine &reng, char *out ) const {
+			auto const seconds =
+			  uniform_int<std::int64_t>{ first_second, last_second }( reng );
+			auto const millis =
+			  with_millis ? static_cast<unsigned>( gen_bounded( reng, 999U ) ) : 0U;
+			return datagen_details::write_iso8601( out, seconds,
+			                                       with_millis ? 3U : 0U, millis );
+		}
+	};
+
+	/// @brief Random (version 4) UUIDs in lower case hex, e.g.
+	/// 0f8fad5b-d9cb-469f-a165-70867728950e
+	struct uuid_text {
+		static constexpr std::size_t max_size = 36U;
+
+		template<typename RandomEngine>
+		constexpr char *operator( )( RandomEngine &reng, char *out ) const {
+			constexpr char const hex[] = "0123456789abcdef";
+			auto hi = gen_random_word( reng );
+			auto lo = gen_random_word( reng );
+			// Version 4 and the RFC 4122 variant
+			hi = ( hi & ~std::uint64_t{ 0xF000 } ) | std::uint64_t{ 0x4000 };
+			lo = ( lo & ( ~std::uint64_t{ 0 } >> 2U ) ) |
+			     ( std::uint64_t{ 1 } << 63U );
+			auto const put = [&]( std::uint64_t word, unsigned first_nibble,
+			                      unsigned count ) {
+				for( unsigned n = 0; n < count; ++n ) {
+					*out++ = hex[( word >> ( 60U - 4U * ( first_nibble + n ) ) ) & 0xFU];
+				}
+			};
+			put( hi, 0, 8 );
+			*out++ = '-';
+			put( hi, 8, 4 );
+			*out++ = '-';
+			put( hi, 12, 4 );
+			*out++ = '-';
+			put( lo, 0, 4 );
+			*out++ = '-';
+			put( lo, 4, 12 );
+			return out;
+		}
+	};
+} // namespace daw::data_gen
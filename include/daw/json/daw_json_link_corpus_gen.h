@@ -0,0 +1,145 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+
+#pragma once
+
+#include "../data_faker/daw_random_engines.h"
+#include "daw_json_link_data_gen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace daw::data_gen {
+	inline constexpr std::size_t default_corpus_shard_size = 1024U;
+
+	/// @brief The seed of the engine used for a document in a corpus.  It only
+	/// depends on the master seed and the position of the document, so any
+	/// document can be regenerated on its own and the corpus does not depend
+	/// on how the work is divided.
+	constexpr std::uint64_t corpus_document_seed( std::uint64_t master_seed,
+	                                              std::uint64_t document_index ) {
+		constexpr std::uint64_t golden_gamma = 0x9E37'79B9'7F4A'7C15ULL;
+		return datagen_details::splitmix64_mix(
+		  datagen_details::splitmix64_mix( master_seed ) +
+		  golden_gamma * ( document_index + 1U ) );
+	}
+
+	/// @brief An engine seeded from all 64 bits of seed.  Engines with
+	/// narrower results, e.g. std::mt19937, get both halves through a
+	/// std::seed_seq unless, like pcg32, they take a 64bit seed
+	template<typename RandomEngine>
+	RandomEngine make_seeded_engine( std::uint64_t seed ) {
+		using result_type = typename RandomEngine::result_type;
+		if constexpr( std::numeric_limits<result_type>::digits >= 64 or
+		              not std::is_constructible_v<RandomEngine,
+		                                          std::seed_seq &> ) {
+			return RandomEngine( seed );
+		} else {
+			auto seq = std::seed_seq{ static_cast<std::uint32_t>( seed ),
+			                          static_cast<std::uint32_t>( seed >> 32U ) };
+			return RandomEngine( seq );
+		}
+	}
+
+	/// @brief Number of shards, and calls to the sink factory, that
+	/// generate_corpus will make
+	constexpr std::size_t
+	corpus_shard_count( std::size_t count,
+	                    std::size_t shard_size = default_corpus_shard_size ) {
+		return ( count + shard_size - 1U ) / shard_size;
+	}
+
+	/// @brief Generate count JSON documents of type T as newline delimited
+	/// JSON.  Documents are split into shards of shard_size consecutive
+	/// documents and each shard is written to its own sink.  The output of
+	/// every shard is identical for any number of threads.
+	/// @tparam T The type whose data contract describes the documents
+	/// @tparam RandomEngine Engine made by make_seeded_engine from each
+	/// documents seed, see corpus_document_seed
+	/// @param seed The master seed of the corpus
+	/// @param threads Number of worker threads, 0 uses the hardware
+	/// concurrency
+	/// @param sink_factory Called as sink_factory( shard_index ) and returns a
+	/// writable output, or a reference to one, for that shard.  It may be
+	/// called from several threads at once.
+	template<typename T, typename RandomEngine = default_random_engine,
+	         typename SinkFactory>
+	void generate_corpus( std::size_t count, std::uint64_t seed,
+	                      std::size_t threads, SinkFactory &&sink_factory,
+	                      std::size_t shard_size = default_corpus_shard_size ) {
+		daw_json_ensure( shard_size > 0, daw::json::ErrorReason::OutputError );
+		auto const shard_count = corpus_shard_count( count, shard_size );
+		if( threads == 0 ) {
+			threads = std::max<std::size_t>( std::thread::hardware_concurrency( ),
+			                                 1U );
+		}
+		threads = std::min( threads, shard_count );
+
+		auto next_shard = std::atomic<std::size_t>{ 0 };
+		auto error = std::exception_ptr{ };
+		auto error_lock = std::mutex{ };
+
+		auto const worker = [&] {
+			try {
+				for( auto shard = next_shard++; shard < shard_count;
+				     shard = next_shard++ ) {
+					decltype( auto ) sink = sink_factory( shard );
+					auto const first = shard * shard_size;
+					auto const last = std::min( first + shard_size, count );
+					for( auto doc = first; doc < last; ++doc ) {
+						auto eng = make_seeded_engine<RandomEngine>(
+						  corpus_document_seed( seed, doc ) );
+						generate_json_for<T>( sink, eng );
+						put_output( sink, '\n' );
+					}
+				}
+			} catch( ... ) {
+				auto const lck = std::lock_guard<std::mutex>( error_lock );
+				if( not error ) {
+					error = std::current_exception( );
+				}
+				// Stop the other workers from starting new shards
+				next_shard = shard_count;
+			}
+		};
+
+		if( threads <= 1 ) {
+			worker( );
+		} else {
+			auto workers = std::vector<std::thread>( );
+			workers.reserve( threads );
+			// A thread that cannot be created throws std::system_error.  Stop
+			// launching and have this thread work alongside those already running,
+			// so every shard is still generated and no joinable thread is destroyed
+			for( std::size_t n = 0; n < threads; ++n ) {
+				try {
+					workers.emplace_back( worker );
+				} catch( std::system_error const & ) {
+					worker( );
+					break;
+				}
+			}
+			for( auto &w : workers ) {
+				w.join( );
+			}
+		}
+		if( error ) {
+			std::rethrow_exception( error );
+		}
+	}
+} // namespace daw::data_gen
@@ -8,33 +8,253 @@
 
 #pragma once
 
+#include "../data_faker/daw_bounded_buffer.h"
+#include "../data_faker/daw_random_engines.h"
 #include "impl/daw_json_generators.h"
+#include "impl/daw_json_plan.h"
+#include "impl/daw_json_regenerators.h"
+#include "impl/daw_json_writers.h"
 
 #include <daw/json/daw_json_link.h>
 
+#include <cstddef>
+#include <memory_resource>
 #include <random>
+#include <type_traits>
 
 namespace daw::data_gen {
+	/// @brief Bounds on the shape of a generated document, so that recursive
+	/// and deeply nested data contracts are generated in bounded time and
+	/// memory.  The defaults leave the bundled schemas unchanged
+	struct generation_limits {
+		/// The deepest nesting of classes and containers.  Arrays and key value
+		/// containers whose elements would be nested deeper are empty, and
+		/// nullable classes and containers null.  Classes that are not
+		/// nullable are always generated.  0 turns it off
+		std::size_t max_depth = 32;
+		/// The most array elements and key value pairs in a document.
+		/// Containers are cut short once it is spent.  0 turns it off
+		std::size_t max_elements = 0;
+		/// Classes and containers enclosing the value being generated
+		std::size_t depth = 0;
+		/// Elements generated so far
+		std::size_t elements = 0;
+
+		/// @brief A value levels deeper than the one being generated would be
+		/// nested deeper than max_depth
+		constexpr bool exceeds_max_depth( std::size_t levels ) const {
+			return max_depth != 0 and depth + levels > max_depth;
+		}
+
+		/// @brief Take up to count elements from what is left, returning how
+		/// many were taken
+		constexpr std::size_t claim_elements( std::size_t count ) {
+			if( max_elements != 0 ) {
+				auto const left = elements < max_elements ? max_elements - elements : 0;
+				count = count < left ? count : left;
+			}
+			elements += count;
+			return count;
+		}
+	};
+
 	struct state_t : daw::json::BasicParsePolicy<> {
-		std::string path{ };
+		/// The path of the value being generated, for member_path_rules
+		path_stack path{ };
+		/// Estimated size of the JSON text generated so far, see
+		/// generate_data_for( target_size )
+		size_budget budget{ };
+		/// When set, containers and strings that can use a
+		/// std::pmr::memory_resource are allocated from it
+		std::pmr::memory_resource *resource = nullptr;
+		/// The timeline of monotonic_dates members, continued from one
+		/// document to the next by data_generator
+		date_clock dates{ };
+		/// How null class members are written by generate_json_for
+		null_output nulls = null_output::write_null;
+		generation_limits limits{ };
 	};
 
 	struct root_name {
 		static constexpr char const value[] = "";
 	};
 
+	namespace datagen_details {
+		template<typename T>
+		using root_json_member =
+		  typename ::daw::json::json_details::json_deduced_type<
+		    T>::template with_name<root_name::value>;
+
+		/// @brief The engine used when none is given.  It has a fixed seed so
+		/// that the output is the same on every platform and standard library
+		inline auto make_default_engine( ) {
+			return default_random_engine( );
+		}
+	} // namespace datagen_details
+
+	/// @brief Generate a T using reng as the source of randomness.  The engine
+	/// is the only mutable state used, so calls on different threads with
+	/// their own engines do not interfere with each other.
+	template<typename T, typename RandomEngine,
+	         std::enable_if_t<not std::is_arithmetic_v<RandomEngine>,
+	                          std::nullptr_t> = nullptr>
+	auto generate_data_for( RandomEngine &reng ) {
+		using json_member = datagen_details::root_json_member<T>;
+		auto state = state_t{ };
+		return datagen_details::value_generator<json_member>{ }( reng, state );
+	}
+
 	template<typename T>
 	inline auto generate_data_for( ) {
-		using namespace daw::json;
-		using json_member_noname = ::daw::json::json_details::json_deduced_type<T>;
-		using json_member =
-		  typename json_member_noname::template with_name<root_name::value>;
-		using minstd_rand =
-		  std::linear_congruential_engine<unsigned int, 48271, 0, 2147483647>;
-		// auto r = std::random_device( );
-		auto r = minstd_rand( );
-		auto eng = std::default_random_engine( r( ) );
+		auto eng = datagen_details::make_default_engine( );
+		return generate_data_for<T>( eng );
+	}
+
+	/// @brief Generate a T whose minified to_json output is close to
+	/// target_size bytes.  The serialized size is estimated while generating,
+	/// the first array or key value container reached grows until the target
+	/// is met and strings and other containers are shortened to fit what is
+	/// left.  The result overshoots by at most about one element of the
+	/// growing container plus the members that follow it, and falls short
+	/// when T has no container to grow.
+	/// @param target_size The requested size in bytes, 0 is the same as
+	/// generate_data_for( reng )
+	/// @param reng The source of randomness, see generate_data_for
+	template<typename T, typename RandomEngine>
+	auto generate_data_for( std::size_t target_size, RandomEngine &reng ) {
+		using json_member = datagen_details::root_json_member<T>;
+		auto state = state_t{ };
+		state.budget.target = target_size;
+		return datagen_details::value_generator<json_member>{ }( reng, state );
+	}
+
+	template<typename T>
+	inline auto generate_data_for( std::size_t target_size ) {
+		auto eng = datagen_details::make_default_engine( );
+		return generate_data_for<T>( target_size, eng );
+	}
+
+	/// @brief Overwrite value with a newly generated T, reusing the strings,
+	/// containers and map nodes it already owns.  reng is drawn from as
+	/// generate_data_for does, so value ends up equal to
+	/// generate_data_for<T>( reng ) from the same engine state.  Once value has
+	/// grown to the lengths being generated, no more allocations are made.
+	/// Classes are regenerated member by member when their to_json_data
+	/// returns references to every member, other values are assigned.
+	/// @param value A T to overwrite
+	/// @param reng The source of randomness, see generate_data_for
+	template<typename T, typename RandomEngine>
+	void regenerate( T &value, RandomEngine &reng ) {
+		using json_member = datagen_details::root_json_member<T>;
+		auto state = state_t{ };
+		datagen_details::value_regenerator<json_member>{ }( reng, state, value );
+	}
+
+	/// @brief Generate a T with every std::pmr container and string in it
+	/// allocated from resource.  With a std::pmr::monotonic_buffer_resource
+	/// the whole document is released at once when the resource is.  The
+	/// result must not outlive resource.
+	/// @param reng The source of randomness, see generate_data_for
+	template<typename T, typename RandomEngine>
+	auto generate_data_for( std::pmr::memory_resource &resource,
+	                        RandomEngine &reng ) {
+		using json_member = datagen_details::root_json_member<T>;
 		auto state = state_t{ };
-		return datagen_details::value_generator<json_member>{ }( eng, state );
+		state.resource = &resource;
+		return datagen_details::value_generator<json_member>{ }( reng, state );
+	}
+
+	template<typename T>
+	inline auto generate_data_for( std::pmr::memory_resource &resource ) {
+		auto eng = datagen_details::make_default_engine( );
+		return generate_data_for<T>( resource, eng );
+	}
+
+	/// @brief Generate the JSON text for a T directly into out, without
+	/// constructing a T.  Memory use is proportional to the nesting depth of
+	/// T's data contract, not the size of the document.  Classes holding
+	/// tagged variants without variant_tag_values are the exception, they are
+	/// generated and serialized into a temporary string with to_json
+	/// @param out Any type with a writable_output_trait specialization, e.g.
+	/// std::FILE *, std::ostream, char *, std::string
+	/// @param reng The source of randomness, see generate_data_for
+	/// @return out, advanced past the generated document
+	template<typename T, typename WritableOutput, typename RandomEngine>
+	WritableOutput &generate_json_for( WritableOutput &out, RandomEngine &reng ) {
+		static_assert( concepts::is_writable_output_type_v<WritableOutput>,
+		               "Output type does not have a writeable_output_trait "
+		               "specialization" );
+		using json_member = datagen_details::root_json_member<T>;
+		auto state = state_t{ };
+		datagen_details::value_writer<json_member>{ }( reng, state, out );
+		return out;
+	}
+
+	template<typename T, typename WritableOutput>
+	WritableOutput &generate_json_for( WritableOutput &out ) {
+		auto eng = datagen_details::make_default_engine( );
+		return generate_json_for<T>( out, eng );
+	}
+
+	/// @brief Generate the same JSON text as generate_json_for, draw for draw,
+	/// by interpreting a plan of T's data contract built at compile time.
+	/// Classes, containers and nullables share one interpreter instead of
+	/// being instantiated for every json type, which builds faster and
+	/// smaller for large data contracts, see daw_json_plan.h
+	/// @param out Any type with a writable_output_trait specialization
+	/// @param reng The source of randomness, see generate_data_for
+	/// @return out, advanced past the generated document
+	template<typename T, typename WritableOutput, typename RandomEngine>
+	WritableOutput &generate_json_with_plan( WritableOutput &out,
+	                                         RandomEngine &reng ) {
+		static_assert( concepts::is_writable_output_type_v<WritableOutput>,
+		               "Output type does not have a writeable_output_trait "
+		               "specialization" );
+		using json_member = datagen_details::root_json_member<T>;
+		auto state = state_t{ };
+		datagen_details::run_plan(
+		  datagen_details::plan_node_for<json_member, RandomEngine, state_t,
+		                                 WritableOutput>::value,
+		  reng, state, out );
+		return out;
+	}
+
+	template<typename T, typename WritableOutput>
+	WritableOutput &generate_json_with_plan( WritableOutput &out ) {
+		auto eng = datagen_details::make_default_engine( );
+		return generate_json_with_plan<T>( out, eng );
+	}
+
+	/// @brief Generate the JSON text for a T into a caller owned buffer without
+	/// allocating.  Arrays and key value containers are cut short where the
+	/// next element would not fit, so the document always fits in the buffer.
+	/// Classes holding tagged variants without variant_tag_values allocate,
+	/// see generate_json_for
+	/// @param buffer The destination, its size is the bound
+	/// @param reng The source of randomness, see generate_data_for
+	/// @return The size of the document
+	/// @throws daw::json::json_exception with OutputError if the buffer cannot
+	/// hold the parts of the document outside of any container
+	template<typename T, typename RandomEngine>
+	std::size_t generate_json_into( bounded_buffer &buffer,
+	                                RandomEngine &reng ) {
+		generate_json_for<T>( buffer, reng );
+		daw_json_ensure( not buffer.overflowed( ),
+		                 daw::json::ErrorReason::OutputError );
+		return buffer.size( );
+	}
+
+	template<typename T, typename RandomEngine>
+	std::size_t generate_json_into( char *first, std::size_t capacity,
+	                                RandomEngine &reng ) {
+		auto buffer = bounded_buffer( first, capacity );
+		return generate_json_into<T>( buffer, reng );
+	}
+
+	/// @brief Generate into a contiguous range of char, e.g. std::array<char,
+	/// N>, std::vector<char> or std::span<char>, see generate_json_into
+	template<typename T, typename Buffer, typename RandomEngine>
+	std::size_t generate_json_into( Buffer &buffer, RandomEngine &reng ) {
+		return generate_json_into<T>( buffer.data( ), buffer.size( ), reng );
 	}
 } // namespace daw::data_gen
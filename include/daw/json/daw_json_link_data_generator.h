@@ -0,0 +1,172 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+
+#pragma once
+
+#include "daw_json_link_data_gen.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+namespace daw::data_gen {
+	/// @brief Generates a stream of distinct T's.  The engine and generation
+	/// state are owned by the generator and kept between calls, so each call
+	/// continues the engine's sequence instead of starting from a fixed seed
+	/// and no setup is repeated per document.  A default constructed
+	/// generator's first document is the one generate_data_for<T>( ) returns.
+	/// A generator is not thread safe, use one per thread.
+	/// @tparam T The type whose data contract describes the documents
+	/// @tparam RandomEngine The source of randomness
+	template<typename T,
+	         typename RandomEngine =
+	           decltype( datagen_details::make_default_engine( ) )>
+	class data_generator {
+		using json_member = datagen_details::root_json_member<T>;
+
+		RandomEngine m_engine;
+		state_t m_state{ };
+
+		state_t &next_state( ) {
+			m_state.budget.used = 0;
+			m_state.budget.expansion_claimed = false;
+			m_state.path.clear( );
+			m_state.limits.depth = 0;
+			m_state.limits.elements = 0;
+			return m_state;
+		}
+
+		static RandomEngine make_engine( ) {
+			if constexpr( std::is_same_v<
+			                RandomEngine,
+			                decltype( datagen_details::make_default_engine( ) )> ) {
+				return datagen_details::make_default_engine( );
+			} else {
+				return RandomEngine( );
+			}
+		}
+
+	public:
+		using value_type = T;
+		using engine_type = RandomEngine;
+
+		data_generator( )
+		  : m_engine( make_engine( ) ) {}
+
+		explicit data_generator( RandomEngine engine )
+		  : m_engine( std::move( engine ) ) {}
+
+		explicit data_generator( typename RandomEngine::result_type seed )
+		  : m_engine( seed ) {}
+
+		/// @brief Steer each document from operator( ) and generate_into towards
+		/// size bytes of JSON, see generate_data_for( target_size ).  0 turns it
+		/// off
+		data_generator &target_size( std::size_t size ) {
+			m_state.budget.target = size;
+			return *this;
+		}
+
+		/// @brief Allocate std::pmr containers and strings of each document
+		/// from resource, see generate_data_for( resource ).  nullptr turns it
+		/// off
+		data_generator &memory_resource( std::pmr::memory_resource *resource ) {
+			m_state.resource = resource;
+			return *this;
+		}
+
+		/// @brief Write null class members of the documents from generate_json
+		/// as "name":null or leave them out.  The default is
+		/// null_output::write_null
+		data_generator &null_members( null_output nulls ) {
+			m_state.nulls = nulls;
+			return *this;
+		}
+
+		/// @brief Cut off classes and containers nested deeper than depth, see
+		/// generation_limits.  0 turns it off
+		data_generator &max_depth( std::size_t depth ) {
+			m_state.limits.max_depth = depth;
+			return *this;
+		}
+
+		/// @brief Generate at most count array elements and key value pairs
+		/// per document, see generation_limits.  0 turns it off
+		data_generator &max_elements( std::size_t count ) {
+			m_state.limits.max_elements = count;
+			return *this;
+		}
+
+		RandomEngine &engine( ) {
+			return m_engine;
+		}
+
+		RandomEngine const &engine( ) const {
+			return m_engine;
+		}
+
+		void seed( typename RandomEngine::result_type s ) {
+			m_engine.seed( s );
+		}
+
+		/// @brief The next document
+		T operator( )( ) {
+			return datagen_details::value_generator<json_member>{ }( m_engine,
+			                                                         next_state( ) );
+		}
+
+		/// @brief Replace value with the next document, reusing the memory it
+		/// owns, see regenerate.  With a size target the document is assigned
+		void generate_into( T &value ) {
+			if( m_state.budget.enabled( ) ) {
+				value = operator( )( );
+				return;
+			}
+			datagen_details::value_regenerator<json_member>{ }(
+			  m_engine, next_state( ), value );
+		}
+
+		/// @brief Write the JSON text of the next document to out, see
+		/// generate_json_for
+		template<typename WritableOutput>
+		WritableOutput &generate_json( WritableOutput &out ) {
+			static_assert( concepts::is_writable_output_type_v<WritableOutput>,
+			               "Output type does not have a writeable_output_trait "
+			               "specialization" );
+			datagen_details::value_writer<json_member>{ }( m_engine, next_state( ),
+			                                               out );
+			return out;
+		}
+
+		/// @brief Write the same JSON text as generate_json, from a plan of T's
+		/// data contract, see generate_json_with_plan
+		template<typename WritableOutput>
+		WritableOutput &generate_json_with_plan( WritableOutput &out ) {
+			static_assert( concepts::is_writable_output_type_v<WritableOutput>,
+			               "Output type does not have a writeable_output_trait "
+			               "specialization" );
+			datagen_details::run_plan(
+			  datagen_details::plan_node_for<json_member, RandomEngine, state_t,
+			                                 WritableOutput>::value,
+			  m_engine, next_state( ), out );
+			return out;
+		}
+
+		/// @brief Write the JSON text of the next document into buffer, see
+		/// generate_json_into
+		/// @return The size of the document
+		std::size_t generate_json_into( bounded_buffer &buffer ) {
+			generate_json( buffer );
+			daw_json_ensure( not buffer.overflowed( ),
+			                 daw::json::ErrorReason::OutputError );
+			return buffer.size( );
+		}
+	};
+} // namespace daw::data_gen
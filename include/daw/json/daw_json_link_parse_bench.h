@@ -0,0 +1,226 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+
+#pragma once
+
+#include "daw_json_link_data_generator.h"
+
+#include <daw/daw_do_not_optimize.h>
+#include <daw/json/daw_json_link.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// A harness for benchmarking daw_json_link on generated documents.  A
+/// corpus is generated once per document size bucket, then from_json,
+/// to_json and json_value iteration are each timed over the whole corpus
+namespace daw::data_gen {
+	struct parse_bench_options {
+		/// Target JSON size of the documents in each bucket, see
+		/// generate_data_for( target_size )
+		std::vector<std::size_t> size_buckets = { 1024U, 64U * 1024U,
+		                                          1024U * 1024U };
+		/// JSON generated for each bucket, at least one document is
+		std::size_t bucket_bytes = 16U * 1024U * 1024U;
+		/// Untimed runs over the corpus before measuring
+		std::size_t warmup_runs = 1;
+		/// Timed runs over the corpus
+		std::size_t runs = 5;
+		std::uint64_t seed = 42;
+	};
+
+	/// @brief Throughput over the timed runs in GB/s of JSON
+	struct throughput_stats {
+		double min = 0.0;
+		double median = 0.0;
+		double mean = 0.0;
+		double max = 0.0;
+		double stddev = 0.0;
+	};
+
+	struct parse_bench_result {
+		/// The bucket's target size
+		std::size_t target_size = 0;
+		std::size_t document_count = 0;
+		/// JSON in the corpus, the bytes every operation processes per run
+		std::size_t json_bytes = 0;
+		throughput_stats from_json{ };
+		throughput_stats to_json{ };
+		throughput_stats json_value{ };
+	};
+
+	namespace datagen_details {
+		inline throughput_stats make_throughput_stats( std::size_t bytes,
+		                                               std::vector<double> secs ) {
+			auto result = throughput_stats{ };
+			if( secs.empty( ) ) {
+				return result;
+			}
+			auto gbps = std::vector<double>( );
+			gbps.reserve( secs.size( ) );
+			for( auto s : secs ) {
+				gbps.push_back( static_cast<double>( bytes ) /
+				                std::max( s, 1.0e-9 ) / 1.0e9 );
+			}
+			std::sort( gbps.begin( ), gbps.end( ) );
+			auto const count = static_cast<double>( gbps.size( ) );
+			result.min = gbps.front( );
+			result.max = gbps.back( );
+			auto const mid = gbps.size( ) / 2U;
+			result.median = gbps.size( ) % 2U == 0
+			                  ? ( gbps[mid - 1U] + gbps[mid] ) / 2.0
+			                  : gbps[mid];
+			for( auto v : gbps ) {
+				result.mean += v;
+			}
+			result.mean /= count;
+			for( auto v : gbps ) {
+				result.stddev += ( v - result.mean ) * ( v - result.mean );
+			}
+			result.stddev = std::sqrt( result.stddev / count );
+			return result;
+		}
+
+		template<typename Func>
+		throughput_stats time_runs( parse_bench_options const &opts,
+		                            std::size_t bytes, Func const &func ) {
+			for( std::size_t n = 0; n < opts.warmup_runs; ++n ) {
+				func( );
+			}
+			auto secs = std::vector<double>( );
+			secs.reserve( opts.runs );
+			for( std::size_t n = 0; n < opts.runs; ++n ) {
+				auto const start = std::chrono::steady_clock::now( );
+				func( );
+				secs.push_back( std::chrono::duration<double>(
+				                  std::chrono::steady_clock::now( ) - start )
+				                  .count( ) );
+			}
+			return make_throughput_stats( bytes, std::move( secs ) );
+		}
+
+		/// @brief Visit every value of a document, returning the count
+		template<typename JsonValue>
+		std::size_t count_json_values( JsonValue const &jv ) {
+			std::size_t result = 1;
+			switch( jv.type( ) ) {
+			case daw::json::JsonBaseParseTypes::Class:
+			case daw::json::JsonBaseParseTypes::Array:
+				for( auto const &jp : jv ) {
+					result += count_json_values( jp.value );
+				}
+				break;
+			default:
+				break;
+			}
+			return result;
+		}
+	} // namespace datagen_details
+
+	/// @brief Generate bucket_bytes of JSON documents of type T aimed at
+	/// target_size bytes each
+	template<typename T>
+	std::vector<std::string> generate_parse_bench_corpus(
+	  std::size_t target_size, std::size_t bucket_bytes, std::uint64_t seed ) {
+		auto gen = data_generator<T>( seed );
+		gen.target_size( target_size );
+		auto docs = std::vector<std::string>( );
+		std::size_t bytes = 0;
+		do {
+			docs.push_back( daw::json::to_json( gen( ) ) );
+			bytes += docs.back( ).size( );
+		} while( bytes < bucket_bytes );
+		return docs;
+	}
+
+	/// @brief Time from_json, to_json and json_value iteration over a
+	/// generated corpus for each size bucket of opts
+	template<typename T>
+	std::vector<parse_bench_result>
+	run_parse_bench( parse_bench_options const &opts = parse_bench_options{ } ) {
+		auto results = std::vector<parse_bench_result>( );
+		for( auto const target_size : opts.size_buckets ) {
+			auto const docs =
+			  generate_parse_bench_corpus<T>( target_size, opts.bucket_bytes,
+			                                  opts.seed + target_size );
+			auto result = parse_bench_result{ };
+			result.target_size = target_size;
+			result.document_count = docs.size( );
+			for( auto const &doc : docs ) {
+				result.json_bytes += doc.size( );
+			}
+
+			result.from_json =
+			  datagen_details::time_runs( opts, result.json_bytes, [&] {
+				  for( auto const &doc : docs ) {
+					  auto value = daw::json::from_json<T>( doc );
+					  daw::do_not_optimize( value );
+				  }
+			  } );
+
+			auto values = std::vector<T>( );
+			values.reserve( docs.size( ) );
+			for( auto const &doc : docs ) {
+				values.push_back( daw::json::from_json<T>( doc ) );
+			}
+			// Serialized documents may differ in size from the corpus, e.g. in
+			// how reals are written
+			std::size_t serialized_bytes = 0;
+			for( auto const &value : values ) {
+				serialized_bytes += daw::json::to_json( value ).size( );
+			}
+			result.to_json = datagen_details::time_runs( opts, serialized_bytes, [&] {
+				for( auto const &value : values ) {
+					auto json = daw::json::to_json( value );
+					daw::do_not_optimize( json );
+				}
+			} );
+
+			result.json_value =
+			  datagen_details::time_runs( opts, result.json_bytes, [&] {
+				  for( auto const &doc : docs ) {
+					  auto count = datagen_details::count_json_values(
+					    daw::json::json_value( std::string_view( doc ) ) );
+					  daw::do_not_optimize( count );
+				  }
+			  } );
+			results.push_back( result );
+		}
+		return results;
+	}
+
+	/// @brief Print one line per bucket and operation, the target and mean
+	/// document size and the median GB/s with the spread of the runs
+	inline void print_parse_bench( char const *name,
+	                               std::vector<parse_bench_result> const &results,
+	                               std::FILE *out = stdout ) {
+		auto const print_stats = [&]( parse_bench_result const &r,
+		                              char const *op,
+		                              throughput_stats const &s ) {
+			std::fprintf( out,
+			              "%-10s target: %9zu B  mean: %9zu B  docs: %6zu  %-10s "
+			              "GB/s median: %7.3f  min: %7.3f  max: %7.3f  "
+			              "stddev: %6.3f\n",
+			              name, r.target_size, r.json_bytes / r.document_count,
+			              r.document_count, op, s.median, s.min, s.max, s.stddev );
+		};
+		for( auto const &r : results ) {
+			print_stats( r, "from_json", r.from_json );
+			print_stats( r, "to_json", r.to_json );
+			print_stats( r, "json_value", r.json_value );
+		}
+	}
+} // namespace daw::data_gen
@@ -9,58 +9,510 @@
 #pragma once
 
 #include "../../data_faker/concepts/daw_writable_output.h"
+#include "../../data_faker/daw_date_policies.h"
+#include "../../data_faker/daw_distributions.h"
+#include "../../data_faker/daw_length_policies.h"
+#include "../../data_faker/daw_number_profiles.h"
+#include "../../data_faker/daw_random_engines.h"
+#include "../../data_faker/daw_text_generators.h"
+#include "daw_json_path_rules.h"
+#include "daw_json_serialized_size.h"
 
 #include <daw/daw_scope_guard.h>
+#include <daw/daw_traits.h>
 #include <daw/json/daw_json_link.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <fmt/format.h>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <optional>
 #include <random>
+#include <ratio>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace daw::data_gen {
-	enum class basic_data_types {
-		String,
-		Signed,
-		Unsigned,
-		Real,
-		Bool,
-		Array,
-		Class,
-		Nullable
-	};
+	// All generators draw through the distributions in daw_distributions.h.
+	// They carry no state between draws, leaving the engine as the only mutable
+	// state, so giving each thread its own engine makes generation thread safe.
+	// Their algorithms are fixed, so a seed gives the same documents with every
+	// standard library
 
 	template<typename>
 	inline constexpr daw::string_view valid_string_chars =
 	  "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789!@#$%^&*()-="
 	  "_+[]{}|;':,.<>/? 	";
 
+	namespace datagen_details {
+		template<typename RandomEngine>
+		using bulk_fill_test = decltype( std::declval<RandomEngine &>( ).fill(
+		  std::declval<std::uint64_t *>( ), std::declval<std::uint64_t *>( ) ) );
+	} // namespace datagen_details
+
+	/// @brief Engines with a fill( first, last ) member that writes the words
+	/// operator( ) would have returned, see daw_random_engines.h
 	template<typename RandomEngine>
-	static char gen_random_character( RandomEngine &reng ) {
-		static_assert( not valid_string_chars<char>.empty( ) );
-		static auto dist = std::uniform_int_distribution<std::size_t>(
-		  0, valid_string_chars<char>.size( ) );
+	inline constexpr bool has_bulk_fill_v =
+	  daw::is_detected_v<datagen_details::bulk_fill_test, RandomEngine>;
 
-		return valid_string_chars<char>.data( )[dist( reng )];
+	/// @brief Fill [first, last) with the words successive calls to
+	/// gen_random_word would give, in one call to the engine when it has a
+	/// bulk fill
+	template<typename RandomEngine>
+	inline void gen_random_words( RandomEngine &reng, std::uint64_t *first,
+	                              std::uint64_t *last ) {
+		if constexpr( has_bulk_fill_v<RandomEngine> ) {
+			reng.fill( first, last );
+		} else {
+			for( ; first != last; ++first ) {
+				*first = gen_random_word( reng );
+			}
+		}
 	}
 
-	template<typename T, typename RandomEngine>
-	T gen_random_string( RandomEngine &reng ) {
-		T result;
-		if constexpr( std::is_same_v<T, std::string> ) {
-			result.reserve( 4096U );
+	namespace datagen_details {
+		template<typename>
+		inline static constexpr std::size_t max_array_size =
+		  100ULL; // 1'000'000ULL;
+	} // namespace datagen_details
+
+	/// @brief Customization point for the length of every generated string of
+	/// type T.  Specialize with a static constexpr value that is a length
+	/// policy, see daw_length_policies.h.  The default is geometric with a
+	/// mean of the size of valid_string_chars
+	template<typename T, typename = void>
+	struct string_length_policy {
+		static constexpr auto value = geometric_length{
+		  static_cast<double>( valid_string_chars<char>.size( ) ) };
+	};
+
+	/// @brief Customization point for the number of elements of every
+	/// generated array or key value container of type Container.
+	template<typename Container, typename = void>
+	struct container_length_policy {
+		static constexpr auto value =
+		  uniform_length{ 0, datagen_details::max_array_size<Container> };
+	};
+
+	namespace datagen_details {
+		template<typename JsonMember>
+		constexpr auto default_member_length_policy( ) {
+			using type = typename JsonMember::parse_to_t;
+			constexpr auto expected_type = JsonMember::expected_type;
+			if constexpr( expected_type == daw::json::JsonParseTypes::StringRaw or
+			              expected_type ==
+			                daw::json::JsonParseTypes::StringEscaped ) {
+				return string_length_policy<type>::value;
+			} else {
+				return container_length_policy<type>::value;
+			}
+		}
+	} // namespace datagen_details
+
+	/// @brief Customization point for the length of a single string, array or
+	/// key value member.  Specialize for the member's json type, e.g.
+	/// json_array<statuses, status_t>, with a static constexpr value that is a
+	/// length policy.  The default uses string_length_policy or
+	/// container_length_policy of the member's type
+	template<typename JsonMember, typename = void>
+	struct member_length_policy {
+		static constexpr auto value =
+		  datagen_details::default_member_length_policy<JsonMember>( );
+	};
+
+	namespace datagen_details {
+		template<typename Number>
+		constexpr auto default_number_profile( ) {
+			if constexpr( std::is_floating_point_v<Number> ) {
+				return unit_reals<Number>{ };
+			} else {
+				return full_range_ints<Number>{ };
+			}
+		}
+	} // namespace datagen_details
+
+	/// @brief Customization point for every generated number of type T.
+	/// Specialize with a static constexpr value that is a number profile, see
+	/// daw_number_profiles.h, e.g. uniform_int<int>{ 0, 100 }.  The default is
+	/// full_range_ints for integers and unit_reals for reals
+	template<typename T, typename = void>
+	struct number_profile_policy {
+		static constexpr auto value =
+		  datagen_details::default_number_profile<T>( );
+	};
+
+	/// @brief Customization point for the numbers of a single member.
+	/// Specialize for the member's json type with a static constexpr value
+	/// that is a number profile, e.g. exponent_reals<double>{ -300, 300 }.  The
+	/// default is number_profile_policy of the member's type
+	template<typename JsonMember, typename = void>
+	struct member_number_profile_policy {
+		static constexpr auto value =
+		  number_profile_policy<typename JsonMember::parse_to_t>::value;
+	};
+
+	/// @brief What generated strings are made of.  Each character is, with the
+	/// given probabilities, one that JSON must escape, a multi-byte UTF-8 code
+	/// point or one of valid_string_chars.  Lengths count characters, not
+	/// bytes
+	struct string_profile {
+		/// Probability of a quote, backslash or control character
+		double escape_density = 0.0;
+		/// Probability of a code point above U+007F, equally likely to be 2, 3
+		/// or 4 bytes of UTF-8.  The 4 byte ones are surrogate pairs in UTF-16
+		double unicode_density = 0.0;
+		/// Write code points above U+007F as \uXXXX escapes instead of UTF-8
+		/// in generated JSON text
+		bool escape_unicode = false;
+
+		constexpr bool is_ascii( ) const {
+			return escape_density <= 0.0 and unicode_density <= 0.0;
+		}
+	};
+
+	/// @brief The most bytes of JSON text a character of profile is written
+	/// as.  Raw strings, json_string_raw, are written without escaping
+	constexpr std::size_t max_serialized_char_size( string_profile profile,
+	                                                bool escaped = true ) {
+		if( not escaped ) {
+			return profile.unicode_density > 0.0 ? 4 : 1;
+		}
+		if( profile.unicode_density > 0.0 and profile.escape_unicode ) {
+			// A surrogate pair
+			return 12;
 		}
-		char c = gen_random_character( reng );
-		while( c != 0 ) {
-			put_output( result, c );
-			c = gen_random_character( reng );
+		if( profile.escape_density > 0.0 ) {
+			// \u00XX
+			return 6;
+		}
+		if( profile.unicode_density > 0.0 ) {
+			return 4;
+		}
+		// Tab is the only character of valid_string_chars escaped
+		return 2;
+	}
+
+	/// @brief Characters from valid_string_chars only
+	inline constexpr auto ascii_strings = string_profile{ };
+	/// @brief A quarter of the characters need escaping, for the slow paths of
+	/// string parsing
+	inline constexpr auto escape_heavy_strings = string_profile{ 0.25 };
+	/// @brief A quarter of the characters are multi-byte UTF-8
+	inline constexpr auto utf8_strings = string_profile{ 0.0, 0.25 };
+	/// @brief A quarter of the characters are written as \uXXXX escapes,
+	/// including surrogate pairs
+	inline constexpr auto unicode_escaped_strings =
+	  string_profile{ 0.0, 0.25, true };
+
+	/// @brief Customization point for the content of every generated string of
+	/// type T.  Specialize with a static constexpr string_profile value.  The
+	/// default is ascii_strings
+	template<typename T, typename = void>
+	struct string_profile_policy {
+		static constexpr auto value = ascii_strings;
+	};
+
+	/// @brief Customization point for the content of a single string member.
+	/// Specialize for the member's json type with a static constexpr
+	/// string_profile value, e.g. escape_heavy_strings.  The default is
+	/// string_profile_policy of the member's type
+	template<typename JsonMember, typename = void>
+	struct member_string_profile_policy {
+		static constexpr auto value =
+		  string_profile_policy<typename JsonMember::parse_to_t>::value;
+	};
+
+	/// @brief Customization point for how often each alternative of a variant
+	/// member is chosen.  Specialize for the member's json type, e.g.
+	/// json_variant<value, std::variant<int, std::string>>, with a static
+	/// constexpr value holding one weight per alternative, e.g.
+	/// std::array<unsigned, 2>{ 9, 1 }.  By default all are equally likely
+	template<typename JsonMember, typename = void>
+	struct variant_weights {};
+
+	/// @brief Customization point for the tag of each alternative of a
+	/// variant member.  Specialize for the member's json type with a static
+	/// constexpr value holding one tag per alternative, e.g.
+	/// std::array<int, 2>{ 0, 1 }.  Intrusive variants require it, their tag
+	/// is stored in the alternative generated.  generate_json_for streams
+	/// classes holding tagged variants when each has it, and otherwise
+	/// generates them and writes them with to_json
+	template<typename JsonMember, typename = void>
+	struct variant_tag_values {};
+
+	/// @brief Customization point for the values of every json_custom member
+	/// of type T.  Specialize with a static constexpr value that is either a
+	/// text generator, see daw_text_generators.h, whose text the member's
+	/// from_converter parses, or a literal type with a const call operator
+	/// taking a random engine and returning a T.  Without one the value is
+	/// default constructed
+	template<typename T, typename = void>
+	struct custom_type_generator {};
+
+	/// @brief Customization point for the values of a single json_custom
+	/// member.  Specialize for the member's json type as with
+	/// custom_type_generator.  The default is custom_type_generator of the
+	/// member's type
+	template<typename JsonMember, typename = void>
+	struct custom_value_generator
+	  : custom_type_generator<typename JsonMember::parse_to_t> {};
+
+	/// @brief Customization point for the timestamps of a json_date member.
+	/// Specialize for the member's json type with a static constexpr value
+	/// that is a date policy, see daw_date_policies.h, e.g.
+	/// monotonic_dates{ start, 10, 500 } for the events of a stream.  The
+	/// default is uniform_dates
+	template<typename JsonMember, typename = void>
+	struct date_policy {
+		static constexpr auto value = uniform_dates{ };
+	};
+
+	/// @brief Nullable members are null numerator times in denominator, e.g.
+	/// null_ratio{ 9, 10 } for sparse optional fields.  denominator must not
+	/// be 0.  The default is 1 in 6
+	struct null_ratio {
+		std::uint64_t numerator = 1;
+		std::uint64_t denominator = 6;
+
+		template<typename RandomEngine>
+		constexpr bool operator( )( RandomEngine &reng ) const {
+			return gen_bounded( reng, denominator - 1U ) < numerator;
+		}
+	};
+
+	inline constexpr auto never_null = null_ratio{ 0, 1 };
+	inline constexpr auto always_null = null_ratio{ 1, 1 };
+
+	/// @brief Customization point for how often nullable members of type T,
+	/// e.g. std::optional<std::string>, are null.  Specialize with a static
+	/// constexpr null_ratio value.  The default is null_ratio{ }
+	template<typename T, typename = void>
+	struct null_rate_policy {
+		static constexpr auto value = null_ratio{ };
+	};
+
+	/// @brief Customization point for how often a single nullable member is
+	/// null.  Specialize for the member's json type, e.g.
+	/// json_string_null<name, std::optional<std::string>>, with a static
+	/// constexpr null_ratio value.  The default is null_rate_policy of the
+	/// member's type
+	template<typename JsonMember, typename = void>
+	struct member_null_rate_policy {
+		static constexpr auto value =
+		  null_rate_policy<typename JsonMember::parse_to_t>::value;
+	};
+
+	/// @brief How null class members are written in generated JSON text
+	enum class null_output {
+		/// "name":null
+		write_null,
+		/// The member is left out
+		omit_member
+	};
+
+	/// @brief The length of the next value generated for JsonMember
+	template<typename JsonMember, typename RandomEngine>
+	std::size_t gen_member_length( RandomEngine &reng ) {
+		return member_length_policy<JsonMember>::value( reng );
+	}
+
+	/// @brief Characters generated per batch of random words
+	inline constexpr std::size_t random_character_block_size = 64U;
+
+	/// @brief Fill [first, first + count) with characters from
+	/// valid_string_chars. Each 64bit random word supplies 4 characters as
+	/// 16bit fractions of the alphabet size, so the mapping is a multiply,
+	/// shift and table load per character that the compiler can vectorize.
+	template<typename RandomEngine>
+	void fill_random_characters( RandomEngine &reng, char *first,
+	                             std::size_t count ) {
+		constexpr auto alphabet = valid_string_chars<char>;
+		static_assert( not alphabet.empty( ) and alphabet.size( ) <= 0xFFFFU );
+		std::uint64_t words[random_character_block_size / 4U];
+		std::uint16_t lanes[random_character_block_size];
+		while( count > 0 ) {
+			auto const block_size = std::min( count, random_character_block_size );
+			gen_random_words( reng, words, words + ( block_size + 3U ) / 4U );
+			for( std::size_t n = 0; n < block_size; n += 4U ) {
+				auto const word = words[n / 4U];
+				lanes[n] = static_cast<std::uint16_t>( word );
+				lanes[n + 1U] = static_cast<std::uint16_t>( word >> 16U );
+				lanes[n + 2U] = static_cast<std::uint16_t>( word >> 32U );
+				lanes[n + 3U] = static_cast<std::uint16_t>( word >> 48U );
+			}
+			for( std::size_t n = 0; n < block_size; ++n ) {
+				auto const idx = static_cast<std::uint32_t>( lanes[n] ) *
+				                 static_cast<std::uint32_t>( alphabet.size( ) );
+				first[n] = alphabet.data( )[idx >> 16U];
+			}
+			first += block_size;
+			count -= block_size;
+		}
+	}
+
+	namespace datagen_details {
+		/// @brief The characters JSON requires escaping
+		inline constexpr char const escaped_string_chars[] =
+		  "\"\\\x00\x01\x02\x03\x04\x05\x06\x07\b\t\n\x0B\f\r\x0E\x0F"
+		  "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F";
+
+		inline constexpr std::size_t escaped_string_char_count =
+		  std::size( escaped_string_chars ) - 1U;
+
+		/// @brief A probability as a threshold for 32 random bits
+		constexpr std::uint64_t probability_threshold( double p ) {
+			if( not( p > 0.0 ) ) {
+				return 0;
+			}
+			if( p >= 1.0 ) {
+				return std::uint64_t{ 1 } << 32U;
+			}
+			return static_cast<std::uint64_t>( p * 4294967296.0 );
+		}
+
+		constexpr char *write_utf8( char *out, std::uint32_t cp ) {
+			if( cp < 0x80U ) {
+				*out++ = static_cast<char>( cp );
+			} else if( cp < 0x800U ) {
+				*out++ = static_cast<char>( 0xC0U | ( cp >> 6U ) );
+				*out++ = static_cast<char>( 0x80U | ( cp & 0x3FU ) );
+			} else if( cp < 0x10000U ) {
+				*out++ = static_cast<char>( 0xE0U | ( cp >> 12U ) );
+				*out++ = static_cast<char>( 0x80U | ( ( cp >> 6U ) & 0x3FU ) );
+				*out++ = static_cast<char>( 0x80U | ( cp & 0x3FU ) );
+			} else {
+				*out++ = static_cast<char>( 0xF0U | ( cp >> 18U ) );
+				*out++ = static_cast<char>( 0x80U | ( ( cp >> 12U ) & 0x3FU ) );
+				*out++ = static_cast<char>( 0x80U | ( ( cp >> 6U ) & 0x3FU ) );
+				*out++ = static_cast<char>( 0x80U | ( cp & 0x3FU ) );
+			}
+			return out;
+		}
+
+		/// @brief A code point above U+007F, the number of UTF-8 bytes it takes
+		/// is chosen first so each is as likely.  Surrogates are skipped
+		template<typename RandomEngine>
+		std::uint32_t gen_non_ascii_code_point( RandomEngine &reng ) {
+			switch( gen_bounded( reng, 2U ) ) {
+			case 0:
+				return static_cast<std::uint32_t>(
+				  0x80U + gen_bounded( reng, 0x7FFU - 0x80U ) );
+			case 1: {
+				auto const cp = static_cast<std::uint32_t>(
+				  0x800U + gen_bounded( reng, 0xFFFFU - 0x800U - 0x800U ) );
+				return cp < 0xD800U ? cp : cp + 0x800U;
+			}
+			default:
+				return static_cast<std::uint32_t>(
+				  0x10000U + gen_bounded( reng, 0x10FFFFU - 0x10000U ) );
+			}
+		}
+	} // namespace datagen_details
+
+	/// @brief The most bytes of UTF-8 a character of the profile takes
+	inline constexpr std::size_t max_profile_char_size = 4U;
+
+	/// @brief Write count characters of profile to out as UTF-8, returning
+	/// the number of bytes written.  out needs room for count *
+	/// max_profile_char_size bytes.  A random word per character chooses its
+	/// kind and the character, multi-byte code points take a few more
+	template<typename RandomEngine>
+	std::size_t fill_profile_characters( RandomEngine &reng,
+	                                     string_profile const &profile,
+	                                     char *out, std::size_t count ) {
+		constexpr auto alphabet = valid_string_chars<char>;
+		auto const escape_threshold =
+		  datagen_details::probability_threshold( profile.escape_density );
+		auto const unicode_threshold =
+		  escape_threshold +
+		  datagen_details::probability_threshold( profile.unicode_density );
+		auto const first = out;
+		for( std::size_t n = 0; n < count; ++n ) {
+			auto const word = gen_random_word( reng );
+			auto const kind = word >> 32U;
+			auto const pick = word & 0xFFFF'FFFFULL;
+			if( kind < escape_threshold ) {
+				*out++ = datagen_details::escaped_string_chars
+				  [( pick * datagen_details::escaped_string_char_count ) >> 32U];
+			} else if( kind < unicode_threshold ) {
+				out = datagen_details::write_utf8(
+				  out, datagen_details::gen_non_ascii_code_point( reng ) );
+			} else {
+				*out++ = alphabet.data( )[( pick * alphabet.size( ) ) >> 32U];
+			}
+		}
+		return static_cast<std::size_t>( out - first );
+	}
+
+	/// @brief Append len characters of profile to str, in blocks
+	template<typename String, typename RandomEngine>
+	void append_profile_characters( String &str, RandomEngine &reng,
+	                                string_profile const &profile,
+	                                std::size_t len ) {
+		char buff[random_character_block_size * max_profile_char_size];
+		while( len > 0 ) {
+			auto const block_size = std::min( len, random_character_block_size );
+			auto const size =
+			  fill_profile_characters( reng, profile, buff, block_size );
+			write_output( str, daw::string_view( buff, size ) );
+			len -= block_size;
+		}
+	}
+
+	/// @brief Generate a random string of profile's characters.  ASCII
+	/// strings of contiguous resizable types are sized exactly once and filled
+	/// in place, others are appended to in blocks
+	/// @param alloc Optional allocator the string is constructed with
+	template<typename T, typename RandomEngine, typename LengthPolicy,
+	         typename... Allocator>
+	T gen_profile_string( RandomEngine &reng, LengthPolicy const &length_policy,
+	                      string_profile const &profile,
+	                      Allocator const &...alloc ) {
+		static_assert( sizeof...( Allocator ) <= 1 );
+		T result( alloc... );
+		auto len = length_policy( reng );
+		if( not profile.is_ascii( ) ) {
+			append_profile_characters( result, reng, profile, len );
+			return result;
+		}
+		if constexpr( concepts::writeable_output_details::
+		                is_resizable_contiguous_range_v<T, char> ) {
+			result.resize( len );
+			fill_random_characters( reng, result.data( ), len );
+		} else {
+			char buff[random_character_block_size];
+			while( len > 0 ) {
+				auto const block_size = std::min( len, random_character_block_size );
+				fill_random_characters( reng, buff, block_size );
+				write_output( result, daw::string_view( buff, block_size ) );
+				len -= block_size;
+			}
 		}
 		return result;
 	}
-	template<basic_data_types, typename, typename = void>
-	struct default_value_generator;
 
-	template<typename T>
-	struct default_value_generator<basic_data_types::String, T> {};
+	/// @brief Generate a random string of characters from valid_string_chars,
+	/// see gen_profile_string
+	template<typename T, typename RandomEngine, typename LengthPolicy,
+	         typename... Allocator>
+	T gen_random_string( RandomEngine &reng, LengthPolicy const &length_policy,
+	                     Allocator const &...alloc ) {
+		return gen_profile_string<T>( reng, length_policy, ascii_strings,
+		                              alloc... );
+	}
+
+	template<typename T, typename RandomEngine>
+	T gen_random_string( RandomEngine &reng ) {
+		return gen_random_string<T>( reng, string_length_policy<T>::value );
+	}
 } // namespace daw::data_gen
 
 namespace daw::data_gen::datagen_details {
@@ -84,14 +536,10 @@ namespace daw::data_gen::datagen_details {
 		               "specialize value_generator" );
 
 		template<typename RandomEngine, typename State>
-		type operator( )( RandomEngine &reng, State const & ) const {
-			static auto dist = std::uniform_real_distribution<type>(
-			  0, 1.0 /*std::numeric_limits<type>::max( )*/ );
-			static auto dsign = std::uniform_int_distribution<int>( 0, 1 );
-			auto result = dist( reng );
-			if( dsign( reng ) ) {
-				return -result;
-			}
+		type operator( )( RandomEngine &reng, State &state ) const {
+			auto const result = static_cast<type>(
+			  member_number_profile_policy<JsonMember>::value( reng ) );
+			add_serialized_size( state, result );
 			return result;
 		}
 	};
@@ -106,10 +554,11 @@ namespace daw::data_gen::datagen_details {
 		  "For non std::is_integral/std::is_signed types, one needs to "
 		  "specialize value_generator" );
 		template<typename RandomEngine, typename State>
-		type operator( )( RandomEngine &reng, State const & ) const {
-			static auto dist = std::uniform_int_distribution<type>(
-			  std::numeric_limits<type>::min( ), std::numeric_limits<type>::max( ) );
-			return dist( reng );
+		type operator( )( RandomEngine &reng, State &state ) const {
+			auto const result = static_cast<type>(
+			  member_number_profile_policy<JsonMember>::value( reng ) );
+			add_serialized_size( state, result );
+			return result;
 		}
 	};
 
@@ -121,10 +570,11 @@ namespace daw::data_gen::datagen_details {
 		               "For non std::is_unsigned types, one needs to specialize "
 		               "value_generator" );
 		template<typename RandomEngine, typename State>
-		type operator( )( RandomEngine &reng, State const & ) const {
-			static auto dist = std::uniform_int_distribution<type>(
-			  0, std::numeric_limits<type>::max( ) );
-			return dist( reng );
+		type operator( )( RandomEngine &reng, State &state ) const {
+			auto const result = static_cast<type>(
+			  member_number_profile_policy<JsonMember>::value( reng ) );
+			add_serialized_size( state, result );
+			return result;
 		}
 	};
 
@@ -136,13 +586,170 @@ namespace daw::data_gen::datagen_details {
 		               "For types not convertible to bool, one must specialize "
 		               "value_generator" );
 		template<typename RandomEngine, typename State>
-		type operator( )( RandomEngine &reng, State const & ) const {
-			static auto dist = std::uniform_int_distribution<unsigned>( 0, 1 );
+		type operator( )( RandomEngine &reng, State &state ) const {
+			auto const result = gen_random_bool( reng );
+			add_serialized_size( state, result );
+			return static_cast<type>( result );
+		}
+	};
+
+	template<typename>
+	inline constexpr bool is_time_point_v = false;
+
+	template<typename Clock, typename Duration>
+	inline constexpr bool
+	  is_time_point_v<std::chrono::time_point<Clock, Duration>> = true;
+
+	/// @brief The digits of fraction of a second in a date's text.  Dates are
+	/// generated to the millisecond, so 3 unless the time_point is coarser than
+	/// that and has a decimal period
+	template<typename JsonMember>
+	constexpr unsigned date_fraction_digits( ) {
+		using type = typename JsonMember::parse_to_t;
+		if constexpr( is_time_point_v<type> ) {
+			using period = typename type::period;
+			if constexpr( not std::ratio_less_v<period, std::ratio<1>> ) {
+				return 0U;
+			} else if constexpr( std::ratio_equal_v<period, std::deci> ) {
+				return 1U;
+			} else if constexpr( std::ratio_equal_v<period, std::centi> ) {
+				return 2U;
+			} else {
+				return 3U;
+			}
+		} else {
+			return 3U;
+		}
+	}
 
-			return static_cast<type>( dist( reng ) );
+	/// @brief The size of a date's ISO 8601 text, without quotes
+	template<typename JsonMember>
+	inline constexpr std::size_t date_text_size =
+	  date_fraction_digits<JsonMember>( ) > 0
+	    ? 21U + date_fraction_digits<JsonMember>( )
+	    : 20U;
+
+	/// @brief The next timestamp of JsonMember's date_policy in milliseconds
+	/// since the epoch, floored to the duration of a time_point member so that
+	/// the text and the value of a date agree
+	template<typename JsonMember, typename RandomEngine, typename State>
+	std::int64_t gen_date_ms( RandomEngine &reng, State &state ) {
+		using type = typename JsonMember::parse_to_t;
+		auto const ms = date_policy<JsonMember>::value( reng, state.dates );
+		if constexpr( is_time_point_v<type> ) {
+			using duration = typename type::duration;
+			if constexpr( std::ratio_greater_v<typename duration::period,
+			                                   std::milli> ) {
+				return std::chrono::floor<std::chrono::milliseconds>(
+				         std::chrono::floor<duration>(
+				           std::chrono::milliseconds( ms ) ) )
+				  .count( );
+			} else {
+				return ms;
+			}
+		} else {
+			return ms;
+		}
+	}
+
+	/// @brief Write ms as ISO 8601 text, date_text_size characters
+	template<typename JsonMember>
+	char *write_date_text( char *out, std::int64_t ms ) {
+		auto const seconds = datagen_details::floor_div( ms, 1000 );
+		return datagen_details::write_iso8601(
+		  out, seconds, date_fraction_digits<JsonMember>( ),
+		  static_cast<unsigned>( ms - seconds * 1000 ) );
+	}
+
+	/// @brief Dates are chosen by the member's date_policy.  time_points are
+	/// made directly, other types by their constructor from the ISO 8601 text
+	/// as when parsing
+	template<typename JsonMember>
+	struct value_generator<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                     JsonMember, JsonParseTypes::Date>>> {
+		using type = typename JsonMember::parse_to_t;
+
+		template<typename RandomEngine, typename State>
+		type operator( )( RandomEngine &reng, State &state ) const {
+			auto const ms = gen_date_ms<JsonMember>( reng, state );
+			if( state.budget.enabled( ) ) {
+				state.budget.add( date_text_size<JsonMember> + 2U );
+			}
+			if constexpr( is_time_point_v<type> ) {
+				return type( std::chrono::floor<typename type::duration>(
+				  std::chrono::milliseconds( ms ) ) );
+			} else {
+				char buff[date_text_size<JsonMember>];
+				write_date_text<JsonMember>( buff, ms );
+				using constructor_t = typename JsonMember::constructor_t;
+				return construct_value(
+				  template_args<daw::json::json_details::json_result<JsonMember>,
+				                constructor_t>,
+				  state, static_cast<char const *>( buff ), std::size( buff ) );
+			}
 		}
 	};
 
+	/// @brief Types whose allocator can be made from a memory resource, e.g.
+	/// the std::pmr containers and strings
+	template<typename T, typename = void>
+	inline constexpr bool uses_memory_resource_v = false;
+
+	template<typename T>
+	inline constexpr bool
+	  uses_memory_resource_v<T, std::void_t<typename T::allocator_type>> =
+	    std::is_constructible_v<typename T::allocator_type,
+	                            std::pmr::memory_resource *>;
+
+	/// @brief Generate a string, in state's memory resource when it has one
+	/// and the string can use it
+	template<typename T, typename RandomEngine, typename State,
+	         typename LengthPolicy>
+	T gen_state_string( RandomEngine &reng, State &state,
+	                    LengthPolicy const &length_policy,
+	                    string_profile const &profile ) {
+		if constexpr( uses_memory_resource_v<T> ) {
+			if( state.resource != nullptr ) {
+				return data_gen::gen_profile_string<T>(
+				  reng, length_policy, profile,
+				  typename T::allocator_type( state.resource ) );
+			}
+		}
+		return data_gen::gen_profile_string<T>( reng, length_policy, profile );
+	}
+
+	/// @brief Generate a string for JsonMember.  When a size target is set,
+	/// the length is clipped so the string fits what is left of the budget
+	template<typename JsonMember, typename RandomEngine, typename State>
+	auto gen_member_string( RandomEngine &reng, State &state ) {
+		using type = typename JsonMember::parse_to_t;
+		auto const &length_policy = member_length_policy<JsonMember>::value;
+		constexpr auto profile = member_string_profile_policy<JsonMember>::value;
+		constexpr bool escaped =
+		  member_is_parse_type_v<JsonMember, JsonParseTypes::StringEscaped>;
+		if( not state.budget.enabled( ) ) {
+			return gen_state_string<type>( reng, state, length_policy, profile );
+		}
+		auto const remaining = state.budget.remaining( );
+		auto max_length = remaining > 2U ? remaining - 2U : 0U;
+		if constexpr( not profile.is_ascii( ) ) {
+			// Lengths count characters, the budget counts bytes of JSON text
+			max_length /= max_serialized_char_size( profile, escaped );
+		}
+		auto result = gen_state_string<type>(
+		  reng, state,
+		  [&]( RandomEngine &r ) {
+			  return std::min( length_policy( r ), max_length );
+		  },
+		  profile );
+		if constexpr( escaped ) {
+			state.budget.add( serialized_string_size( result ) );
+		} else {
+			state.budget.add( std::size( result ) + 2U );
+		}
+		return result;
+	}
+
 	template<typename JsonMember>
 	struct value_generator<JsonMember,
 	                       std::enable_if_t<member_is_parse_type_v<
@@ -150,8 +757,8 @@ namespace daw::data_gen::datagen_details {
 		using type = typename JsonMember::parse_to_t;
 
 		template<typename RandomEngine, typename State>
-		type operator( )( RandomEngine &reng, State const & ) const {
-			return data_gen::gen_random_string<type>( reng );
+		type operator( )( RandomEngine &reng, State &state ) const {
+			return gen_member_string<JsonMember>( reng, state );
 		}
 	};
 
@@ -162,11 +769,140 @@ namespace daw::data_gen::datagen_details {
 		using type = typename JsonMember::parse_to_t;
 
 		template<typename RandomEngine, typename State>
-		type operator( )( RandomEngine &reng, State const & ) const {
-			return data_gen::gen_random_string<type>( reng );
+		type operator( )( RandomEngine &reng, State &state ) const {
+			return gen_member_string<JsonMember>( reng, state );
 		}
 	};
 
+	/// @brief Counts a class or container towards the depth of the values
+	/// generated inside it, see generation_limits
+	template<typename State>
+	class nesting_guard {
+		State *m_state;
+
+	public:
+		explicit nesting_guard( State &state )
+		  : m_state( std::addressof( state ) ) {
+			++m_state->limits.depth;
+		}
+
+		nesting_guard( nesting_guard const & ) = delete;
+		nesting_guard &operator=( nesting_guard const & ) = delete;
+
+		~nesting_guard( ) {
+			--m_state->limits.depth;
+		}
+	};
+
+	/// @brief Whether JsonMember, or a value inside it at most Depth path
+	/// segments down, has member_path_rules, see path_rules_inside_v
+	template<typename JsonMember, std::size_t Depth>
+	constexpr bool has_path_rules_inside( );
+
+	/// @brief Only values with member_path_rules look at the path, so values
+	/// without any inside them do not track it.  Rules deeper than
+	/// max_path_depth segments match nothing and are not looked for
+	template<typename JsonMember>
+	inline constexpr bool path_rules_inside_v =
+	  has_path_rules_inside<JsonMember, max_path_depth>( );
+
+	/// @brief Adds a segment to the path of the values generated inside it
+	/// when track is set, see path_stack and path_rules_inside_v
+	template<typename State>
+	class path_guard {
+		State *m_state;
+
+	public:
+		path_guard( State &state, std::string_view segment, bool track )
+		  : m_state( track ? std::addressof( state ) : nullptr ) {
+			if( track ) {
+				m_state->path.push( segment );
+			}
+		}
+
+		path_guard( path_guard const & ) = delete;
+		path_guard &operator=( path_guard const & ) = delete;
+
+		~path_guard( ) {
+			if( m_state != nullptr ) {
+				m_state->path.pop( );
+			}
+		}
+	};
+
+	template<typename JsonMember>
+	constexpr std::string_view member_path_segment( ) {
+		auto const name = daw::string_view( JsonMember::name );
+		return std::string_view( name.data( ), name.size( ) );
+	}
+
+	/// @brief The path segment of the elements of an array or key value
+	/// container
+	template<typename JsonMember>
+	constexpr std::string_view element_path_segment( ) {
+		if constexpr( JsonMember::expected_type ==
+		              daw::json::JsonParseTypes::KeyValue ) {
+			return key_value_segment;
+		} else {
+			return array_element_segment;
+		}
+	}
+
+	template<typename JsonMember>
+	inline constexpr bool is_nested_member_v =
+	  member_is_parse_type_v<JsonMember, JsonParseTypes::Class> or
+	  member_is_parse_type_v<JsonMember, JsonParseTypes::Array> or
+	  member_is_parse_type_v<JsonMember, JsonParseTypes::KeyValue>;
+
+	/// @brief How much deeper than an array or key value container its
+	/// elements are nested
+	template<typename JsonMember>
+	constexpr std::size_t container_content_levels( ) {
+		if constexpr( member_is_parse_type_v<JsonMember,
+		                                     JsonParseTypes::KeyValue> ) {
+			return is_nested_member_v<
+			         daw::json::json_link_no_name<
+			           typename JsonMember::value_type_t>>
+			         ? 2U
+			         : 1U;
+		} else {
+			return is_nested_member_v<typename JsonMember::json_element_t> ? 2U
+			                                                                 : 1U;
+		}
+	}
+
+	/// @brief The container of JsonMember is empty, without drawing a length,
+	/// because its elements would be nested too deep
+	template<typename JsonMember, typename State>
+	constexpr bool container_exceeds_depth( State const &state ) {
+		return state.limits.exceeds_max_depth(
+		  container_content_levels<JsonMember>( ) );
+	}
+
+	/// @brief The length of the next array or key value container of
+	/// JsonMember within state's generation_limits
+	template<typename JsonMember, typename RandomEngine, typename State>
+	std::size_t gen_container_length( RandomEngine &reng, State &state ) {
+		if( container_exceeds_depth<JsonMember>( state ) ) {
+			return 0;
+		}
+		return state.limits.claim_elements(
+		  gen_member_length<JsonMember>( reng ) );
+	}
+
+	/// @brief Decide if a nullable member is empty, see
+	/// member_null_rate_policy.  Nullable classes and containers that would be
+	/// nested too deep are always empty, which ends recursive data contracts
+	template<typename JsonMember, typename RandomEngine, typename State>
+	constexpr bool gen_is_null( RandomEngine &reng, State &state ) {
+		if constexpr( is_nested_member_v<typename JsonMember::member_type> ) {
+			if( state.limits.exceeds_max_depth( 1 ) ) {
+				return true;
+			}
+		}
+		return member_null_rate_policy<JsonMember>::value( reng );
+	}
+
 	template<typename JsonMember>
 	struct value_generator<JsonMember, std::enable_if_t<member_is_parse_type_v<
 	                                     JsonMember, JsonParseTypes::Null>>> {
@@ -174,7 +910,6 @@ namespace daw::data_gen::datagen_details {
 
 		template<typename RandomEngine, typename State>
 		type operator( )( RandomEngine &reng, State &state ) const {
-			static auto dist = std::uniform_int_distribution<unsigned>( 0, 5 );
 			using constructor_t = typename JsonMember::constructor_t;
 			auto const construct_empty = [&] {
 				if constexpr( std::is_invocable_v<constructor_t,
@@ -189,8 +924,7 @@ namespace daw::data_gen::datagen_details {
 					  state );
 				}
 			};
-			auto const v = dist( reng );
-			if( not static_cast<bool>( v ) ) {
+			if( gen_is_null<JsonMember>( reng, state ) ) {
 				return construct_empty( );
 			} else {
 				using base_member_type = typename JsonMember::member_type;
@@ -201,21 +935,148 @@ namespace daw::data_gen::datagen_details {
 		}
 	};
 
-	template<typename>
-	inline static constexpr std::size_t max_array_size = 100ULL; // 1'000'000ULL;
-
 	template<typename JsonMember>
 	struct value_generator<JsonMember, std::enable_if_t<member_is_parse_type_v<
 	                                     JsonMember, JsonParseTypes::Array>>>;
 
+	/// @brief Construct a Container with Constructor from the generated
+	/// elements in [first, last).  Containers using the default constructor
+	/// that can use state's memory resource are allocated from it.  Members of
+	/// the same container type share it
+	template<typename Container, typename Constructor, typename State,
+	         typename Iterator>
+	Container construct_container_of( State &state, Iterator first,
+	                                  Iterator last ) {
+		if constexpr( uses_memory_resource_v<Container> and
+		              std::is_same_v<Constructor,
+		                             daw::json::default_constructor<Container>> ) {
+			if( state.resource != nullptr ) {
+				using alloc_t = typename Container::allocator_type;
+				if constexpr( std::is_constructible_v<Container, Iterator, Iterator,
+				                                      alloc_t> ) {
+					return Container( first, last, alloc_t( state.resource ) );
+				} else {
+					// Unordered containers take a bucket count before the allocator
+					return Container(
+					  first, last,
+					  static_cast<typename Container::size_type>( last - first ),
+					  alloc_t( state.resource ) );
+				}
+			}
+		}
+		return construct_value( template_args<Container, Constructor>, state,
+		                        first, last );
+	}
+
+	/// @brief Construct the container of JsonMember from the generated
+	/// elements in [first, last), see construct_container_of
+	template<typename JsonMember, typename State, typename Iterator>
+	auto construct_container( State &state, Iterator first, Iterator last ) {
+		return construct_container_of<
+		  daw::json::json_details::json_result<JsonMember>,
+		  typename JsonMember::constructor_t>( state, first, last );
+	}
+
+	/// @brief Generate a value that is always written, such as an array
+	/// element. Empty nullables are written as null instead of being omitted
+	template<typename JsonMember, typename RandomEngine, typename State>
+	auto gen_counted_value( RandomEngine &reng, State &state ) {
+		auto const used = state.budget.used;
+		auto result = value_generator<JsonMember>{ }( reng, state );
+		if( state.budget.enabled( ) and state.budget.used == used ) {
+			state.budget.add( 4 );
+		}
+		return result;
+	}
+
+	/// @brief Generates an array element while a size target is set
+	template<typename JsonElement>
+	struct counted_element_generator {
+		template<typename RandomEngine, typename State>
+		auto operator( )( RandomEngine &reng, State &state ) const {
+			return gen_counted_value<JsonElement>( reng, state );
+		}
+	};
+
+	/// @brief Generates a key value pair while a size target is set
+	template<typename KeyMember, typename ValueMember>
+	struct counted_pair_generator {
+		template<typename RandomEngine, typename State>
+		auto operator( )( RandomEngine &reng, State &state ) const {
+			auto key = value_generator<KeyMember>{ }( reng, state );
+			// Keys are always quoted and followed by a colon
+			if constexpr( KeyMember::expected_type ==
+			                JsonParseTypes::StringEscaped or
+			              KeyMember::expected_type == JsonParseTypes::StringRaw ) {
+				state.budget.add( 1 );
+			} else {
+				state.budget.add( 3 );
+			}
+			using kv_t = std::pair<typename KeyMember::parse_to_t,
+			                       typename ValueMember::parse_to_t>;
+			return kv_t{ std::move( key ),
+			             gen_counted_value<ValueMember>( reng, state ) };
+		}
+	};
+
+	template<typename ElementGenerator, typename RandomEngine, typename State>
+	using generated_elements_t = std::vector<decltype( ElementGenerator{ }(
+	  std::declval<RandomEngine &>( ), std::declval<State &>( ) ) )>;
+
+	/// @brief Generate up to count elements while the budget lasts.  It only
+	/// depends on the elements, so containers of the same elements share it
+	template<typename ElementGenerator, typename RandomEngine, typename State>
+	generated_elements_t<ElementGenerator, RandomEngine, State>
+	gen_elements_while_budget( RandomEngine &reng, State &state,
+	                           std::size_t count ) {
+		auto elements =
+		  generated_elements_t<ElementGenerator, RandomEngine, State>( );
+		while( elements.size( ) < count and state.budget.remaining( ) > 0 and
+		       state.limits.claim_elements( 1 ) == 1 ) {
+			if( not elements.empty( ) ) {
+				// Separator
+				state.budget.add( 1 );
+			}
+			elements.push_back( ElementGenerator{ }( reng, state ) );
+		}
+		return elements;
+	}
+
+	/// @brief Generate the elements of an array or key value container while
+	/// a size target is set.  The first container reached grows until the
+	/// budget is spent, the others keep their length policy but stop early
+	/// when nothing is left.  The result overshoots by at most one element.
+	template<typename JsonMember, typename ElementGenerator,
+	         typename RandomEngine, typename State>
+	generated_elements_t<ElementGenerator, RandomEngine, State>
+	gen_elements_to_budget( RandomEngine &reng, State &state ) {
+		auto &budget = state.budget;
+		// Brackets
+		budget.add( 2 );
+		if( container_exceeds_depth<JsonMember>( state ) ) {
+			return { };
+		}
+		bool const expand = not std::exchange( budget.expansion_claimed, true );
+		auto const count = expand ? std::numeric_limits<std::size_t>::max( )
+		                          : gen_member_length<JsonMember>( reng );
+		auto const nesting = nesting_guard<State>( state );
+		auto const element_path =
+		  path_guard<State>( state, element_path_segment<JsonMember>( ),
+		                     path_rules_inside_v<JsonMember> );
+		return gen_elements_while_budget<ElementGenerator>( reng, state, count );
+	}
+
 	template<typename JsonMember>
 	struct value_generator<JsonMember, std::enable_if_t<member_is_parse_type_v<
 	                                     JsonMember, JsonParseTypes::Class>>>;
 
-	template<typename JsonMember, typename RandomEngine, typename State>
+	/// @brief Generates the elements of arrays whose elements are
+	/// JsonElement.  It only depends on the element type, so arrays of the
+	/// same elements in different members and containers share it
+	template<typename JsonElement, typename RandomEngine, typename State>
 	struct value_generator_array_iterator {
 		using iterator_category = std::random_access_iterator_tag;
-		using value_type = typename JsonMember::json_element_parse_to_t;
+		using value_type = daw::json::json_details::json_result<JsonElement>;
 		using reference = value_type &;
 		using pointer = value_type *;
 		using difference_type = std::ptrdiff_t;
@@ -267,27 +1128,18 @@ namespace daw::data_gen::datagen_details {
 
 		constexpr void ensure_last( ) const {
 			if( not m_last ) {
-				m_last = value_generator<typename JsonMember::json_element_t>{ }(
-				  *m_engine, *m_state );
+				m_last = value_generator<JsonElement>{ }( *m_engine, *m_state );
 			}
 		}
 
-		constexpr value_type const &operator*( ) const {
+		// The element is owned by the iterator, allow moving it out through a
+		// const iterator, e.g. std::move_iterator
+		constexpr value_type &operator*( ) const {
 			ensure_last( );
 			return *m_last;
 		}
 
-		constexpr value_type &operator*( ) {
-			ensure_last( );
-			return *m_last;
-		}
-
-		constexpr value_type const *operator->( ) const {
-			ensure_last( );
-			return std::addressof( *m_last );
-		}
-
-		constexpr value_type *operator->( ) {
+		constexpr value_type *operator->( ) const {
 			ensure_last( );
 			return std::addressof( *m_last );
 		}
@@ -323,18 +1175,19 @@ namespace daw::data_gen::datagen_details {
 		}
 	};
 
-	template<typename JsonMember, typename RandomEngine, typename State>
+	/// @brief Generates the pairs of key value containers whose keys are
+	/// KeyMember and values ValueMember, unnamed, so containers of the same
+	/// pairs share it
+	template<typename KeyMember, typename ValueMember, typename RandomEngine,
+	         typename State>
 	struct value_generator_kv_iterator {
 		using iterator_category = std::random_access_iterator_tag;
-		using key_type_t =
-		  daw::json::json_link_no_name<typename JsonMember::key_type_t>;
-		using value_type_t =
-		  daw::json::json_link_no_name<typename JsonMember::value_type_t>;
+		using key_type_t = KeyMember;
+		using value_type_t = ValueMember;
 		using kv_t = std::pair<typename key_type_t::parse_to_t,
 		                       typename value_type_t::parse_to_t>;
-		using container_t = typename JsonMember::parse_to_t;
-		using constructor_t = typename JsonMember::constructor_t;
 
+		using value_type = kv_t;
 		using reference = kv_t &;
 		using pointer = kv_t *;
 		using difference_type = std::ptrdiff_t;
@@ -392,22 +1245,14 @@ namespace daw::data_gen::datagen_details {
 			}
 		}
 
-		constexpr kv_t const &operator*( ) const {
+		// The element is owned by the iterator, allow moving it out through a
+		// const iterator, e.g. std::move_iterator
+		constexpr kv_t &operator*( ) const {
 			ensure_last( );
 			return *m_last;
 		}
 
-		constexpr kv_t &operator*( ) {
-			ensure_last( );
-			return *m_last;
-		}
-
-		constexpr kv_t const *operator->( ) const {
-			ensure_last( );
-			return std::addressof( *m_last );
-		}
-
-		constexpr kv_t *operator->( ) {
+		constexpr kv_t *operator->( ) const {
 			ensure_last( );
 			return std::addressof( *m_last );
 		}
@@ -445,21 +1290,75 @@ namespace daw::data_gen::datagen_details {
 		template<typename RandomEngine, typename State>
 		DAW_ATTRIB_FLATTEN type operator( )( RandomEngine &reng,
 		                                     State &state ) const {
-			static auto sz_dist =
-			  std::uniform_int_distribution<unsigned>( 0, max_array_size<type> );
-			auto const ary_size = sz_dist( reng );
+			if( state.budget.enabled( ) ) {
+				auto elements = gen_elements_to_budget<
+				  JsonMember,
+				  counted_element_generator<typename JsonMember::json_element_t>>(
+				  reng, state );
+				return construct_container<JsonMember>(
+				  state, std::make_move_iterator( elements.begin( ) ),
+				  std::make_move_iterator( elements.end( ) ) );
+			}
+			auto const ary_size = gen_container_length<JsonMember>( reng, state );
+			auto const nesting = nesting_guard<State>( state );
+			auto const element_path =
+			  path_guard<State>( state, element_path_segment<JsonMember>( ),
+			                     path_rules_inside_v<JsonMember> );
 			using it_t =
-			  value_generator_array_iterator<JsonMember, RandomEngine, State>;
-			auto first = it_t( reng, state );
-			auto last = it_t( ary_size );
-			using constructor_t = typename JsonMember::constructor_t;
-			return construct_value(
-			  template_args<daw::json::json_details::json_result<JsonMember>,
-			                constructor_t>,
-			  state, first, last );
+			  value_generator_array_iterator<typename JsonMember::json_element_t,
+			                                 RandomEngine, State>;
+			// Each element is generated once, move it into the container
+			auto first = std::make_move_iterator( it_t( reng, state ) );
+			auto last = std::make_move_iterator( it_t( ary_size ) );
+			return construct_container<JsonMember>( state, first, last );
 		}
 	};
 
+	template<typename JsonMember>
+	using custom_value_generator_test =
+	  decltype( custom_value_generator<JsonMember>::value );
+
+	template<typename JsonMember>
+	inline constexpr bool has_custom_value_generator_v =
+	  daw::is_detected_v<custom_value_generator_test, JsonMember>;
+
+	template<typename Generator>
+	using text_generator_test = decltype( Generator::max_size );
+
+	/// @brief The member's custom_value_generator writes text instead of
+	/// returning values
+	template<typename JsonMember>
+	constexpr bool has_custom_text_generator( ) {
+		if constexpr( has_custom_value_generator_v<JsonMember> ) {
+			return daw::is_detected_v<
+			  text_generator_test,
+			  std::remove_cv_t<custom_value_generator_test<JsonMember>>>;
+		} else {
+			return false;
+		}
+	}
+
+	template<typename JsonMember>
+	using custom_json_type_test = decltype( JsonMember::custom_json_type );
+
+	/// @brief Literal custom members are written without quotes
+	template<typename JsonMember>
+	constexpr bool is_custom_literal( ) {
+		if constexpr( daw::is_detected_v<custom_json_type_test, JsonMember> ) {
+			return JsonMember::custom_json_type ==
+			       daw::json::JsonCustomTypes::Literal;
+		} else {
+			return false;
+		}
+	}
+
+	template<typename JsonMember>
+	inline constexpr std::size_t custom_quote_size =
+	  is_custom_literal<JsonMember>( ) ? 0U : 2U;
+
+	/// @brief Custom members are generated by their custom_value_generator.
+	/// Generated text is parsed by the member's from_converter, as the parser
+	/// would
 	template<typename JsonMember>
 	struct value_generator<JsonMember, std::enable_if_t<member_is_parse_type_v<
 	                                     JsonMember, JsonParseTypes::Custom>>> {
@@ -468,20 +1367,29 @@ namespace daw::data_gen::datagen_details {
 		template<typename RandomEngine, typename State>
 		DAW_ATTRIB_FLATTEN type operator( )( RandomEngine &reng,
 		                                     State &state ) const {
-			/*
-			static auto sz_dist =
-			  std::uniform_int_distribution<unsigned>( 0, max_array_size<type> );
-			auto const ary_size = sz_dist( reng );
-			using it_t =
-			  value_generator_array_iterator<JsonMember, RandomEngine, State>;
-			auto first = it_t( reng, state );
-			auto last = it_t( ary_size );
-			using constructor_t = typename JsonMember::constructor_t;
-			return construct_value(
-			  template_args<daw::json::json_details::json_result<JsonMember>,
-			constructor_t>, state, first, last );
-			  */
-			return { };
+			if constexpr( has_custom_text_generator<JsonMember>( ) ) {
+				constexpr auto const &gen = custom_value_generator<JsonMember>::value;
+				char buff[gen.max_size];
+				auto const size =
+				  static_cast<std::size_t>( gen( reng, buff ) - buff );
+				if( state.budget.enabled( ) ) {
+					state.budget.add( size + custom_quote_size<JsonMember> );
+				}
+				return typename JsonMember::from_converter_t{ }(
+				  std::string_view( buff, size ) );
+			} else {
+				auto result = [&] {
+					if constexpr( has_custom_value_generator_v<JsonMember> ) {
+						return type( custom_value_generator<JsonMember>::value( reng ) );
+					} else {
+						return type{ };
+					}
+				}( );
+				if( state.budget.enabled( ) ) {
+					state.budget.add( daw::json::to_json<JsonMember>( result ).size( ) );
+				}
+				return result;
+			}
 		}
 	};
 
@@ -493,49 +1401,174 @@ namespace daw::data_gen::datagen_details {
 		template<typename RandomEngine, typename State>
 		DAW_ATTRIB_FLATTEN type operator( )( RandomEngine &reng,
 		                                     State &state ) const {
-
-			static auto sz_dist =
-			  std::uniform_int_distribution<unsigned>( 0, max_array_size<type> );
-			auto const ary_size = sz_dist( reng );
-			using it_t = value_generator_kv_iterator<JsonMember, RandomEngine, State>;
-			auto first = it_t( reng, state );
-			auto last = it_t( ary_size );
-			using constructor_t = typename JsonMember::constructor_t;
-			return construct_value(
-			  template_args<daw::json::json_details::json_result<JsonMember>,
-			                constructor_t>,
-			  state, first, last );
+			using it_t = value_generator_kv_iterator<
+			  daw::json::json_link_no_name<typename JsonMember::key_type_t>,
+			  daw::json::json_link_no_name<typename JsonMember::value_type_t>,
+			  RandomEngine, State>;
+			if( state.budget.enabled( ) ) {
+				auto elements = gen_elements_to_budget<
+				  JsonMember, counted_pair_generator<typename it_t::key_type_t,
+				                                     typename it_t::value_type_t>>(
+				  reng, state );
+				return construct_container<JsonMember>(
+				  state, std::make_move_iterator( elements.begin( ) ),
+				  std::make_move_iterator( elements.end( ) ) );
+			}
+			auto const ary_size = gen_container_length<JsonMember>( reng, state );
+			auto const nesting = nesting_guard<State>( state );
+			auto const element_path =
+			  path_guard<State>( state, element_path_segment<JsonMember>( ),
+			                     path_rules_inside_v<JsonMember> );
+			auto first = std::make_move_iterator( it_t( reng, state ) );
+			auto last = std::make_move_iterator( it_t( ary_size ) );
+			return construct_container<JsonMember>( state, first, last );
 		}
 	};
 
+	template<typename JsonMember>
+	using member_path_rules_test =
+	  decltype( member_path_rules<JsonMember>::value );
+
+	template<typename JsonMember>
+	inline constexpr bool has_member_path_rules_v =
+	  daw::is_detected_v<member_path_rules_test, JsonMember>;
+
+	/// @brief Call on_match with the generator of the first of JsonMember's
+	/// member_path_rules matching state's path
+	/// @return Whether a rule matched
+	template<typename JsonMember, typename State, typename Func>
+	bool with_path_rule( State const &state, Func &&on_match ) {
+		return std::apply(
+		  [&]( auto const &...rules ) {
+			  return ( ( state.path.matches( rules.path ) and
+			             ( on_match( rules.generator ), true ) ) or
+			           ... );
+		  },
+		  member_path_rules<JsonMember>::value );
+	}
+
+	/// @brief Generate a value of JsonMember with the generator of a
+	/// path_rule
+	template<typename JsonMember, typename Generator, typename RandomEngine>
+	auto gen_rule_value( Generator const &gen, RandomEngine &reng ) {
+		using type = typename JsonMember::parse_to_t;
+		if constexpr( daw::is_detected_v<text_generator_test, Generator> ) {
+			char buff[Generator::max_size];
+			auto const size = static_cast<std::size_t>( gen( reng, buff ) - buff );
+			return type( std::string_view( buff, size ) );
+		} else {
+			return type( gen( reng ) );
+		}
+	}
+
+	/// @brief Generate a class member, with the first of its member_path_rules
+	/// that matches the path when it has any
+	template<typename JsonMember, typename RandomEngine, typename State>
+	auto gen_member_value( RandomEngine &reng, State &state ) {
+		using json_member = daw::json::json_link_no_name<JsonMember>;
+		if constexpr( has_member_path_rules_v<JsonMember> ) {
+			auto result = std::optional<typename json_member::parse_to_t>( );
+			bool const matched =
+			  with_path_rule<JsonMember>( state, [&]( auto const &gen ) {
+				  result.emplace( gen_rule_value<json_member>( gen, reng ) );
+			  } );
+			if( matched ) {
+				if( state.budget.enabled( ) ) {
+					state.budget.add(
+					  daw::json::to_json<json_member>( *result ).size( ) );
+				}
+				return std::move( *result );
+			}
+		}
+		return value_generator<json_member>{ }( reng, state );
+	}
+
 	template<typename JsonMember, typename RandomEngine, typename State>
 	constexpr auto visit_json_member( RandomEngine &reng, State &state ) {
-		/*
-		auto old_path = DAW_MOVE( state.path );
-		auto const ae = daw::on_exit_success( [&] {
-		  state.path = DAW_MOVE( old_path );
-		} );
-		state.path = fmt::format(
-		  "{}.{}", old_path, static_cast<std::string_view>( JsonMember::name ) );*/
-		return value_generator<daw::json::json_link_no_name<JsonMember>>{ }(
+		auto const member_path =
+		  path_guard<State>( state, member_path_segment<JsonMember>( ),
+		                     path_rules_inside_v<JsonMember> );
+		auto const used = state.budget.used;
+		auto result = gen_member_value<JsonMember>( reng, state );
+		// Empty nullable members are omitted, others add "name":value,
+		if( state.budget.enabled( ) and state.budget.used != used ) {
+			state.budget.add( daw::string_view( JsonMember::name ).size( ) + 4U );
+		}
+		return result;
+	}
+
+	template<typename JsonMember, typename RandomEngine, typename State>
+	constexpr auto visit_json_tuple_member( RandomEngine &reng, State &state ) {
+		auto result = gen_counted_value<daw::json::json_link_no_name<JsonMember>>(
 		  reng, state );
+		// Separator
+		if( state.budget.enabled( ) ) {
+			state.budget.add( 1 );
+		}
+		return result;
+	}
+
+	/// @brief Size of the brackets of a class less the trailing separator
+	/// counted by its last member
+	template<typename State>
+	constexpr void add_class_brackets_size( State &state,
+	                                        std::size_t used_before ) {
+		if( state.budget.enabled( ) ) {
+			state.budget.add( state.budget.used != used_before ? 1 : 2 );
+		}
+	}
+
+	/// @brief Construct JsonMember's class from its generated members
+	template<typename JsonMember, typename State, typename... Members>
+	auto construct_class( State &state, std::tuple<Members...> &&members ) {
+		using constructor_t = typename JsonMember::constructor_t;
+		return std::apply(
+		  [&]( Members &&...ms ) {
+			  return construct_value(
+			    template_args<daw::json::json_details::json_result<JsonMember>,
+			                  constructor_t>,
+			    state, std::move( ms )... );
+		  },
+		  std::move( members ) );
 	}
 
+	template<typename>
+	inline constexpr bool has_tagged_variant_member_v = false;
+
+	template<typename... JsonMembers>
+	inline constexpr bool
+	  has_tagged_variant_member_v<daw::json::json_member_list<JsonMembers...>> =
+	    ( member_is_parse_type_v<JsonMembers, JsonParseTypes::VariantTagged> or
+	      ... );
+
 	template<typename, typename>
 	struct class_generator;
 
+	template<typename, typename>
+	struct tagged_class_generator;
+
 	template<typename JsonMember, typename... JsonMembers>
 	struct class_generator<JsonMember,
 	                       daw::json::json_member_list<JsonMembers...>> {
 		using type = typename JsonMember::parse_to_t;
+		using member_list_t = daw::json::json_member_list<JsonMembers...>;
 
 		template<typename RandomEngine, typename State>
 		type operator( )( RandomEngine &reng, State &state ) const {
-			using constructor_t = typename JsonMember::constructor_t;
-			return construct_value(
-			  template_args<daw::json::json_details::json_result<JsonMember>,
-			                constructor_t>,
-			  state, visit_json_member<JsonMembers>( reng, state )... );
+			if constexpr( has_tagged_variant_member_v<member_list_t> ) {
+				return tagged_class_generator<JsonMember, member_list_t>{ }( reng,
+				                                                           state );
+			} else {
+				auto const used = state.budget.used;
+				// Braced initialization generates the members in order, function
+				// arguments would be in an order that depends on the compiler
+				auto result = construct_class<JsonMember>(
+				  state, std::tuple<decltype( visit_json_member<JsonMembers>(
+				           reng, state ) )...>{
+				           visit_json_member<JsonMembers>( reng, state )... } );
+				add_class_brackets_size( state, used );
+				return result;
+			}
 		}
 	};
 
@@ -546,12 +1579,15 @@ namespace daw::data_gen::datagen_details {
 
 		template<typename RandomEngine, typename State>
 		type operator( )( RandomEngine &reng, State &state ) const {
-			using constructor_t = typename JsonMember::constructor_t;
-
-			return construct_value(
-			  template_args<daw::json::json_details::json_result<JsonMember>,
-			                constructor_t>,
-			  state, visit_json_member<JsonMembers>( reng, state )... );
+			auto const used = state.budget.used;
+			// Braced initialization generates the members in order, function
+			// arguments would be in an order that depends on the compiler
+			auto result = construct_class<JsonMember>(
+			  state, std::tuple<decltype( visit_json_tuple_member<JsonMembers>(
+			           reng, state ) )...>{
+			           visit_json_tuple_member<JsonMembers>( reng, state )... } );
+			add_class_brackets_size( state, used );
+			return result;
 		}
 	};
 
@@ -563,10 +1599,431 @@ namespace daw::data_gen::datagen_details {
 		template<typename RandomEngine, typename State>
 		DAW_ATTRIB_FLATTEN type operator( )( RandomEngine &reng,
 		                                     State &state ) const {
-
+			auto const nesting = nesting_guard<State>( state );
 			return class_generator<JsonMember, daw::json::json_data_contract_trait_t<
 			                                     typename JsonMember::base_type>>{ }(
 			  reng, state );
 		}
 	};
+
+	template<typename T>
+	using to_json_data_test =
+	  decltype( daw::json::json_data_contract<T>::to_json_data(
+	    std::declval<T const &>( ) ) );
+
+	template<typename>
+	struct variant_element_list;
+
+	template<template<typename...> typename TypeList, typename... JsonElements>
+	struct variant_element_list<TypeList<JsonElements...>> {
+		using type = std::tuple<
+		  daw::json::json_details::json_deduced_type<JsonElements>...>;
+	};
+
+	/// @brief The json types of the alternatives of a variant member
+	template<typename JsonMember>
+	using variant_elements_t =
+	  typename variant_element_list<typename JsonMember::json_elements>::type;
+
+	template<typename JsonMember, std::size_t Index>
+	using variant_element_t =
+	  std::tuple_element_t<Index, variant_elements_t<JsonMember>>;
+
+	template<typename JsonMember>
+	inline constexpr std::size_t variant_size_v =
+	  std::tuple_size_v<variant_elements_t<JsonMember>>;
+
+	/// @brief Members of contracts not walked here are assumed to have
+	/// member_path_rules
+	template<typename MemberList, std::size_t Depth>
+	struct member_list_path_rules : std::true_type {};
+
+	template<typename... JsonMembers, std::size_t Depth>
+	struct member_list_path_rules<daw::json::json_member_list<JsonMembers...>,
+	                              Depth>
+	  : std::bool_constant<(
+	      ( has_member_path_rules_v<JsonMembers> or
+	        has_path_rules_inside<daw::json::json_link_no_name<JsonMembers>,
+	                              Depth - 1U>( ) ) or
+	      ... )> {};
+
+	/// @brief Tuple members add no segment, but are counted as one so that
+	/// recursive contracts are walked a finite depth
+	template<typename... JsonMembers, std::size_t Depth>
+	struct member_list_path_rules<
+	  daw::json::json_tuple_member_list<JsonMembers...>, Depth>
+	  : std::bool_constant<(
+	      has_path_rules_inside<daw::json::json_link_no_name<JsonMembers>,
+	                            Depth - 1U>( ) or
+	      ... )> {};
+
+	template<typename JsonMember, std::size_t Depth, std::size_t... Is>
+	constexpr bool variant_path_rules_inside( std::index_sequence<Is...> ) {
+		return ( has_path_rules_inside<variant_element_t<JsonMember, Is>,
+		                               Depth>( ) or
+		         ... );
+	}
+
+	template<typename JsonMember, std::size_t Depth>
+	constexpr bool has_path_rules_inside( ) {
+		constexpr auto expected_type = JsonMember::expected_type;
+		if constexpr( Depth == 0 ) {
+			return false;
+		} else if constexpr( has_member_path_rules_v<JsonMember> ) {
+			return true;
+		} else if constexpr( expected_type == JsonParseTypes::Class ) {
+			return member_list_path_rules<daw::json::json_data_contract_trait_t<
+			                                typename JsonMember::base_type>,
+			                              Depth>::value;
+		} else if constexpr( expected_type == JsonParseTypes::Array ) {
+			return has_path_rules_inside<typename JsonMember::json_element_t,
+			                             Depth - 1U>( );
+		} else if constexpr( expected_type == JsonParseTypes::KeyValue ) {
+			return has_path_rules_inside<
+			         daw::json::json_link_no_name<typename JsonMember::key_type_t>,
+			         Depth - 1U>( ) or
+			       has_path_rules_inside<
+			         daw::json::json_link_no_name<typename JsonMember::value_type_t>,
+			         Depth - 1U>( );
+		} else if constexpr( expected_type == JsonParseTypes::Null ) {
+			return has_path_rules_inside<typename JsonMember::member_type,
+			                             Depth>( );
+		} else if constexpr( expected_type == JsonParseTypes::Variant or
+		                     expected_type == JsonParseTypes::VariantTagged or
+		                     expected_type ==
+		                       JsonParseTypes::VariantIntrusive ) {
+			return variant_path_rules_inside<JsonMember, Depth>(
+			  std::make_index_sequence<variant_size_v<JsonMember>>{ } );
+		} else {
+			return false;
+		}
+	}
+
+	template<typename JsonMember>
+	using variant_weights_test = decltype( variant_weights<JsonMember>::value );
+
+	template<typename JsonMember>
+	constexpr std::uint64_t variant_total_weight( ) {
+		std::uint64_t result = 0;
+		for( auto weight : variant_weights<JsonMember>::value ) {
+			result += weight;
+		}
+		return result;
+	}
+
+	/// @brief The index of the alternative to generate, chosen by
+	/// variant_weights
+	template<typename JsonMember, typename RandomEngine>
+	std::size_t gen_variant_index( RandomEngine &reng ) {
+		constexpr auto size = variant_size_v<JsonMember>;
+		static_assert( size > 0, "A variant needs at least one alternative" );
+		if constexpr( daw::is_detected_v<variant_weights_test, JsonMember> ) {
+			constexpr auto const &weights = variant_weights<JsonMember>::value;
+			static_assert( std::size( weights ) == size,
+			               "variant_weights needs one weight per alternative" );
+			constexpr auto total = variant_total_weight<JsonMember>( );
+			static_assert( total > 0, "variant_weights are all 0" );
+			auto r = gen_bounded( reng, total - 1U );
+			std::size_t index = 0;
+			for( auto weight : weights ) {
+				if( r < weight ) {
+					break;
+				}
+				r -= weight;
+				++index;
+			}
+			return index;
+		} else {
+			return static_cast<std::size_t>( gen_bounded( reng, size - 1U ) );
+		}
+	}
+
+	/// @brief Call func with std::integral_constant<std::size_t, index>.  The
+	/// alternatives are known at compile time, so this is a chain of compares
+	/// instead of an indirect call
+	template<std::size_t Index, std::size_t Size, typename Func>
+	decltype( auto ) visit_index( std::size_t index, Func &&func ) {
+		if constexpr( Index + 1U == Size ) {
+			return func( std::integral_constant<std::size_t, Index>{ } );
+		} else {
+			if( index == Index ) {
+				return func( std::integral_constant<std::size_t, Index>{ } );
+			}
+			return visit_index<Index + 1U, Size>( index, func );
+		}
+	}
+
+	/// @brief Generate alternative index of JsonMember's variant
+	template<typename JsonMember, typename RandomEngine, typename State>
+	auto gen_variant_alternative( RandomEngine &reng, State &state,
+	                              std::size_t index ) {
+		using constructor_t = typename JsonMember::constructor_t;
+		return visit_index<0, variant_size_v<JsonMember>>(
+		  index, [&]( auto alternative ) {
+			  using element_t =
+			    variant_element_t<JsonMember, decltype( alternative )::value>;
+			  return construct_value(
+			    template_args<daw::json::json_details::json_result<JsonMember>,
+			                  constructor_t>,
+			    state, value_generator<element_t>{ }( reng, state ) );
+		  } );
+	}
+
+	/// @brief Variants generate one alternative, chosen by variant_weights.  A
+	/// tagged variant's tag is not generated, it is computed from the class
+	/// by the member's switcher when serializing.  In a class its alternative
+	/// is chosen before the class's members, see tagged_class_generator
+	template<typename JsonMember>
+	struct value_generator<
+	  JsonMember,
+	  std::enable_if_t<
+	    member_is_parse_type_v<JsonMember, JsonParseTypes::Variant> or
+	    member_is_parse_type_v<JsonMember, JsonParseTypes::VariantTagged>>> {
+		using type = typename JsonMember::parse_to_t;
+
+		template<typename RandomEngine, typename State>
+		type operator( )( RandomEngine &reng, State &state ) const {
+			return gen_variant_alternative<JsonMember>(
+			  reng, state, gen_variant_index<JsonMember>( reng ) );
+		}
+	};
+
+	template<typename JsonMember>
+	using variant_tag_t = typename daw::json::json_link_no_name<
+	  typename JsonMember::tag_member>::parse_to_t;
+
+	template<typename JsonMember>
+	using variant_tag_values_test =
+	  decltype( variant_tag_values<JsonMember>::value );
+
+	template<typename JsonMember>
+	inline constexpr bool has_variant_tag_values_v =
+	  daw::is_detected_v<variant_tag_values_test, JsonMember>;
+
+	/// @brief The tag of alternative index, see variant_tag_values
+	template<typename JsonMember>
+	variant_tag_t<JsonMember> variant_tag( std::size_t index ) {
+		static_assert( has_variant_tag_values_v<JsonMember>,
+		               "Specialize variant_tag_values with the tag of each "
+		               "alternative of the variant" );
+		constexpr auto const &tags = variant_tag_values<JsonMember>::value;
+		static_assert( std::size( tags ) == variant_size_v<JsonMember>,
+		               "variant_tag_values needs one tag per alternative" );
+		return variant_tag_t<JsonMember>( tags[index] );
+	}
+
+	template<typename JsonMember, typename OtherMember>
+	constexpr bool same_member_name( ) {
+		return daw::string_view( JsonMember::name ) ==
+		       daw::string_view( OtherMember::name );
+	}
+
+	/// @brief The name of a tagged variant's tag member, empty for other
+	/// members
+	template<typename JsonMember>
+	constexpr daw::string_view variant_tag_name( ) {
+		if constexpr( member_is_parse_type_v<JsonMember,
+		                                     JsonParseTypes::VariantTagged> ) {
+			return daw::string_view( JsonMember::tag_member::name );
+		} else {
+			return daw::string_view( );
+		}
+	}
+
+	/// @brief The tag members of a class holding tagged variants.  to_json
+	/// writes them ahead of the other members, once per name, and skips the
+	/// members sharing a tag's name
+	template<typename... JsonMembers>
+	struct class_variant_tags {
+		static constexpr daw::string_view names[] = {
+		  variant_tag_name<JsonMembers>( )... };
+
+		/// @brief Member index is the first tagged variant with its tag member
+		static constexpr bool writes_tag( std::size_t index ) {
+			if( names[index].empty( ) ) {
+				return false;
+			}
+			for( std::size_t n = 0; n < index; ++n ) {
+				if( names[n] == names[index] ) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		static constexpr bool is_tag( daw::string_view name ) {
+			for( auto tag : names ) {
+				if( not tag.empty( ) and tag == name ) {
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	/// @brief The alternative of a tagged variant member, no draw for other
+	/// members
+	template<typename JsonMember, typename RandomEngine>
+	std::size_t gen_tagged_variant_index( RandomEngine &reng ) {
+		if constexpr( member_is_parse_type_v<JsonMember,
+		                                     JsonParseTypes::VariantTagged> ) {
+			return gen_variant_index<JsonMember>( reng );
+		} else {
+			(void)reng;
+			return 0;
+		}
+	}
+
+	/// @brief A member of a class holding tagged variants, tagged variants
+	/// generate the alternative chosen up front
+	template<typename JsonMember, typename RandomEngine, typename State>
+	auto visit_tagged_class_member( RandomEngine &reng, State &state,
+	                                std::size_t index ) {
+		if constexpr( member_is_parse_type_v<JsonMember,
+		                                     JsonParseTypes::VariantTagged> ) {
+			static_assert( not has_member_path_rules_v<JsonMember>,
+			               "member_path_rules are not supported on tagged variant "
+			               "members" );
+			auto const member_path =
+			  path_guard<State>( state, member_path_segment<JsonMember>( ),
+			                     path_rules_inside_v<JsonMember> );
+			auto const used = state.budget.used;
+			auto result =
+			  gen_variant_alternative<daw::json::json_link_no_name<JsonMember>>(
+			    reng, state, index );
+			if( state.budget.enabled( ) and state.budget.used != used ) {
+				state.budget.add( daw::string_view( JsonMember::name ).size( ) + 4U );
+			}
+			return result;
+		} else {
+			(void)index;
+			return visit_json_member<JsonMember>( reng, state );
+		}
+	}
+
+	/// @brief to_json writes the tags of a class's tagged variants ahead of
+	/// its members, so generate_json_for has to know the alternatives first.
+	/// They are chosen before the members, in member order, both here and
+	/// when writing JSON
+	template<typename JsonMember, typename... JsonMembers>
+	struct tagged_class_generator<JsonMember,
+	                              daw::json::json_member_list<JsonMembers...>> {
+		using type = typename JsonMember::parse_to_t;
+
+		template<typename RandomEngine, typename State, std::size_t... Is>
+		static type
+		generate( RandomEngine &reng, State &state,
+		          std::array<std::size_t, sizeof...( JsonMembers )> const &indices,
+		          std::index_sequence<Is...> ) {
+			return construct_class<JsonMember>(
+			  state, std::tuple<decltype( visit_tagged_class_member<JsonMembers>(
+			           reng, state, indices[Is] ) )...>{
+			           visit_tagged_class_member<JsonMembers>( reng, state,
+			                                                   indices[Is] )... } );
+		}
+
+		template<typename RandomEngine, typename State>
+		type operator( )( RandomEngine &reng, State &state ) const {
+			// Braced initialization draws in member order
+			auto const indices = std::array<std::size_t, sizeof...( JsonMembers )>{
+			  gen_tagged_variant_index<JsonMembers>( reng )... };
+			auto const used = state.budget.used;
+			auto result = generate( reng, state, indices,
+			                        std::index_sequence_for<JsonMembers...>{ } );
+			add_class_brackets_size( state, used );
+			return result;
+		}
+	};
+
+	/// @brief A member of an intrusive variant's alternative, the one named
+	/// like the variant's tag member is the tag instead of being generated
+	template<typename JsonMember, typename TagMember, typename RandomEngine,
+	         typename State, typename Tag>
+	auto visit_intrusive_member( RandomEngine &reng, State &state,
+	                             Tag const &tag ) {
+		if constexpr( same_member_name<JsonMember, TagMember>( ) ) {
+			using json_member = daw::json::json_link_no_name<JsonMember>;
+			using member_t = typename json_member::parse_to_t;
+			static_assert( std::is_constructible_v<member_t, Tag const &>,
+			               "The tag member of an intrusive variant alternative "
+			               "must be constructible from the tag" );
+			auto result = member_t( tag );
+			if( state.budget.enabled( ) ) {
+				state.budget.add(
+				  daw::string_view( JsonMember::name ).size( ) + 4U +
+				  daw::json::to_json<json_member>( result ).size( ) );
+			}
+			return result;
+		} else {
+			(void)tag;
+			return visit_json_member<JsonMember>( reng, state );
+		}
+	}
+
+	template<typename JsonMember, typename TagMember, typename MemberList>
+	struct intrusive_alternative_generator {
+		static_assert( not std::is_same_v<MemberList, MemberList>,
+		               "The alternatives of an intrusive variant need a "
+		               "json_member_list data contract" );
+	};
+
+	/// @brief Generate an intrusive variant's alternative with tag passed to
+	/// its constructor in place of its tag member
+	template<typename JsonMember, typename TagMember, typename... JsonMembers>
+	struct intrusive_alternative_generator<
+	  JsonMember, TagMember, daw::json::json_member_list<JsonMembers...>> {
+		static_assert( ( same_member_name<JsonMembers, TagMember>( ) or ... ),
+		               "The alternatives of an intrusive variant need a member "
+		               "named like its tag member" );
+		using type = typename JsonMember::parse_to_t;
+
+		template<typename RandomEngine, typename State, typename Tag>
+		type operator( )( RandomEngine &reng, State &state,
+		                  Tag const &tag ) const {
+			auto const nesting = nesting_guard<State>( state );
+			auto const used = state.budget.used;
+			// Braced initialization generates the members in order
+			auto result = construct_class<JsonMember>(
+			  state,
+			  std::tuple<decltype( visit_intrusive_member<JsonMembers, TagMember>(
+			    reng, state, tag ) )...>{
+			    visit_intrusive_member<JsonMembers, TagMember>( reng, state,
+			                                                    tag )... } );
+			add_class_brackets_size( state, used );
+			return result;
+		}
+	};
+
+	/// @brief Intrusive variants keep their tag in the alternative's object.
+	/// The alternative chosen is constructed with its tag, see
+	/// variant_tag_values
+	template<typename JsonMember>
+	struct value_generator<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                     JsonMember,
+	                                     JsonParseTypes::VariantIntrusive>>> {
+		using type = typename JsonMember::parse_to_t;
+
+		template<typename RandomEngine, typename State>
+		type operator( )( RandomEngine &reng, State &state ) const {
+			using constructor_t = typename JsonMember::constructor_t;
+			using tag_member_t = typename JsonMember::tag_member;
+			return visit_index<0, variant_size_v<JsonMember>>(
+			  gen_variant_index<JsonMember>( reng ), [&]( auto index ) {
+				  constexpr auto alternative_index = decltype( index )::value;
+				  using element_t = variant_element_t<JsonMember, alternative_index>;
+				  static_assert(
+				    member_is_parse_type_v<element_t, JsonParseTypes::Class>,
+				    "The alternatives of an intrusive variant are classes" );
+				  using member_list_t = daw::json::json_data_contract_trait_t<
+				    typename element_t::base_type>;
+				  return construct_value(
+				    template_args<daw::json::json_details::json_result<JsonMember>,
+				                  constructor_t>,
+				    state,
+				    intrusive_alternative_generator<element_t, tag_member_t,
+				                                    member_list_t>{ }(
+				      reng, state, variant_tag<JsonMember>( alternative_index ) ) );
+			  } );
+		}
+	};
 } // namespace daw::data_gen::datagen_details
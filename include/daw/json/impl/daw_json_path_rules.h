@@ -0,0 +1,108 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace daw::data_gen {
+	inline constexpr std::string_view array_element_segment = "[]";
+	inline constexpr std::string_view key_value_segment = "{}";
+	inline constexpr std::size_t max_path_depth = 32U;
+
+	/// @brief The path of the value being generated, e.g.
+	/// statuses[].user.screen_name.  Segments are member names, "[]" for the
+	/// elements of an array or "{}" for the values of a key value container.
+	/// They refer to the names in the data contracts, so nothing is allocated.
+	/// Paths deeper than max_path_depth are counted but not kept, and match
+	/// nothing
+	class path_stack {
+		std::array<std::string_view, max_path_depth> m_segments{ };
+		std::size_t m_size = 0;
+
+		static constexpr bool is_element( std::string_view segment ) {
+			return segment == array_element_segment or
+			       segment == key_value_segment;
+		}
+
+	public:
+		constexpr void push( std::string_view segment ) {
+			if( m_size < max_path_depth ) {
+				m_segments[m_size] = segment;
+			}
+			++m_size;
+		}
+
+		constexpr void pop( ) {
+			--m_size;
+		}
+
+		constexpr void clear( ) {
+			m_size = 0;
+		}
+
+		constexpr std::size_t size( ) const {
+			return m_size;
+		}
+
+		constexpr bool empty( ) const {
+			return m_size == 0;
+		}
+
+		/// @brief The path is pattern, with member names separated by dots and
+		/// element segments appended, e.g. statuses[].user.screen_name.  The
+		/// members of a root array start with [], e.g. [].id
+		constexpr bool matches( std::string_view pattern ) const {
+			if( m_size > max_path_depth ) {
+				return false;
+			}
+			std::size_t pos = 0;
+			for( std::size_t n = 0; n < m_size; ++n ) {
+				auto const segment = m_segments[n];
+				if( n > 0 and not is_element( segment ) ) {
+					if( pos >= pattern.size( ) or pattern[pos] != '.' ) {
+						return false;
+					}
+					++pos;
+				}
+				if( pattern.substr( pos, segment.size( ) ) != segment ) {
+					return false;
+				}
+				pos += segment.size( );
+			}
+			return pos == pattern.size( );
+		}
+	};
+
+	/// @brief Generate the member at path with generator, see
+	/// member_path_rules.  The generator is either a text generator, see
+	/// daw_text_generators.h, whose text the member's type is constructed
+	/// from, or a literal type with a const call operator taking a random
+	/// engine and returning a value the member's type is constructed from,
+	/// e.g. uniform_int<int>{ 0, 100 }
+	template<typename Generator>
+	struct path_rule {
+		std::string_view path;
+		Generator generator;
+	};
+
+	template<typename Generator>
+	path_rule( std::string_view, Generator ) -> path_rule<Generator>;
+
+	/// @brief Customization point for generating a member differently
+	/// depending on where it is in the document, e.g. the user of a retweet.
+	/// Specialize for the member's json type with a static constexpr
+	/// std::tuple of path_rule.  The first rule whose path matches is used,
+	/// otherwise the member is generated as usual.  Only members with rules
+	/// look at the path, and it is only tracked through values that have such
+	/// members inside them, so contracts without rules do not pay for it
+	template<typename JsonMember, typename = void>
+	struct member_path_rules {};
+} // namespace daw::data_gen
@@ -0,0 +1,294 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+
+#pragma once
+
+#include "daw_json_generators.h"
+#include "daw_json_writers.h"
+
+#include <daw/json/daw_json_link.h>
+
+#include <cstddef>
+#include <string_view>
+
+/// A plan is a data contract flattened at compile time into a table of
+/// nodes, one per json type, holding the kind of value and its parameters.
+/// Classes, containers and nullables are walked by a single interpreter loop
+/// instead of a template instantiation per json type, leaves are written by
+/// their value_writer.  The output is the same as value_writer's, draw for
+/// draw.
+namespace daw::data_gen::datagen_details {
+	enum class plan_op : unsigned char { Leaf, Class, Array, KeyValue, Null };
+
+	template<typename RandomEngine, typename State, typename WritableOutput>
+	struct plan_node;
+
+	/// @brief A member of a class, in data contract order
+	template<typename RandomEngine, typename State, typename WritableOutput>
+	struct plan_member {
+		using rule_fn = bool ( * )( RandomEngine &, State &, WritableOutput &,
+		                            bool & );
+
+		std::string_view name{ };
+		/// bounded_member_size of the member
+		std::size_t bound = 0;
+		plan_node<RandomEngine, State, WritableOutput> const *node = nullptr;
+		/// Writes the member when one of its member_path_rules matches, null
+		/// when it has none
+		rule_fn write_rule = nullptr;
+		/// path_rules_inside_v of the member
+		bool tracks_path = false;
+	};
+
+	template<typename RandomEngine, typename State, typename WritableOutput>
+	struct plan_node {
+		using write_fn = void ( * )( RandomEngine &, State &, WritableOutput & );
+		using length_fn = std::size_t ( * )( RandomEngine &, State & );
+		using is_null_fn = bool ( * )( RandomEngine &, State & );
+
+		plan_op op = plan_op::Leaf;
+		/// The value of a Leaf or the key of a KeyValue
+		write_fn write = nullptr;
+		/// gen_container_length of an Array or KeyValue
+		length_fn length = nullptr;
+		/// gen_is_null of a Null
+		is_null_fn is_null = nullptr;
+		/// The elements of an Array, values of a KeyValue or the value of a
+		/// Null
+		plan_node const *element = nullptr;
+		plan_member<RandomEngine, State, WritableOutput> const *members = nullptr;
+		std::size_t member_count = 0;
+		/// class_bounded_size of a Class
+		std::size_t bound = 0;
+		/// element_path_segment of an Array or KeyValue
+		std::string_view segment{ };
+		/// path_rules_inside_v of an Array or KeyValue
+		bool tracks_path = false;
+	};
+
+	/// @brief The functions a plan points to, one instantiation per json type
+	/// instead of one per json type and enclosing value
+	template<typename RandomEngine, typename State, typename WritableOutput>
+	struct plan_fns {
+		template<typename JsonMember>
+		static void write_value( RandomEngine &reng, State &state,
+		                         WritableOutput &out ) {
+			value_writer<JsonMember>{ }( reng, state, out );
+		}
+
+		template<typename JsonMember>
+		static void write_key_value( RandomEngine &reng, State &state,
+		                             WritableOutput &out ) {
+			write_key<JsonMember>( reng, state, out );
+		}
+
+		template<typename JsonMember>
+		static std::size_t container_length( RandomEngine &reng, State &state ) {
+			return gen_container_length<JsonMember>( reng, state );
+		}
+
+		template<typename JsonMember>
+		static bool is_null( RandomEngine &reng, State &state ) {
+			return gen_is_null<JsonMember>( reng, state );
+		}
+
+		template<typename JsonMember>
+		static bool write_rule( RandomEngine &reng, State &state,
+		                        WritableOutput &out, bool &is_first ) {
+			return write_path_rule_member<JsonMember>( reng, state, out, is_first );
+		}
+	};
+
+	/// @brief The node of JsonMember.  Nodes refer to each other by address,
+	/// so recursive data contracts have a finite plan
+	template<typename JsonMember, typename RandomEngine, typename State,
+	         typename WritableOutput>
+	struct plan_node_for;
+
+	template<typename JsonMember, typename RandomEngine, typename State,
+	         typename WritableOutput>
+	constexpr plan_member<RandomEngine, State, WritableOutput>
+	make_plan_member( ) {
+		using json_member = daw::json::json_link_no_name<JsonMember>;
+		using fns = plan_fns<RandomEngine, State, WritableOutput>;
+		auto result = plan_member<RandomEngine, State, WritableOutput>{ };
+		result.name = member_path_segment<JsonMember>( );
+		result.bound = bounded_member_size<JsonMember>( );
+		result.tracks_path = path_rules_inside_v<JsonMember>;
+		result.node =
+		  &plan_node_for<json_member, RandomEngine, State, WritableOutput>::value;
+		if constexpr( has_member_path_rules_v<JsonMember> ) {
+			result.write_rule = &fns::template write_rule<JsonMember>;
+		}
+		return result;
+	}
+
+	template<typename MemberList, typename RandomEngine, typename State,
+	         typename WritableOutput>
+	struct plan_class_members;
+
+	/// @brief The members of a class, followed by an empty one so that
+	/// classes without members have a table too
+	template<typename... JsonMembers, typename RandomEngine, typename State,
+	         typename WritableOutput>
+	struct plan_class_members<daw::json::json_member_list<JsonMembers...>,
+	                          RandomEngine, State, WritableOutput> {
+		static constexpr std::size_t size = sizeof...( JsonMembers );
+		static constexpr plan_member<RandomEngine, State, WritableOutput>
+		  value[size + 1U] = {
+		    make_plan_member<JsonMembers, RandomEngine, State,
+		                     WritableOutput>( )...,
+		    plan_member<RandomEngine, State, WritableOutput>{ } };
+	};
+
+	template<typename>
+	inline constexpr bool is_plan_member_list_v = false;
+
+	template<typename... JsonMembers>
+	inline constexpr bool
+	  is_plan_member_list_v<daw::json::json_member_list<JsonMembers...>> =
+	    not has_tagged_variant_member_v<
+	      daw::json::json_member_list<JsonMembers...>>;
+
+	/// @brief Classes whose members the interpreter writes.  Tuple classes
+	/// and those holding tagged variants are leaves written by value_writer
+	template<typename JsonMember>
+	constexpr bool is_plan_class( ) {
+		if constexpr( member_is_parse_type_v<JsonMember, JsonParseTypes::Class> ) {
+			return is_plan_member_list_v<daw::json::json_data_contract_trait_t<
+			  typename JsonMember::base_type>>;
+		} else {
+			return false;
+		}
+	}
+
+	template<typename JsonMember, typename RandomEngine, typename State,
+	         typename WritableOutput>
+	constexpr plan_node<RandomEngine, State, WritableOutput> make_plan_node( ) {
+		using fns = plan_fns<RandomEngine, State, WritableOutput>;
+		auto result = plan_node<RandomEngine, State, WritableOutput>{ };
+		if constexpr( is_plan_class<JsonMember>( ) ) {
+			using member_list_t =
+			  daw::json::json_data_contract_trait_t<typename JsonMember::base_type>;
+			using members_t = plan_class_members<member_list_t, RandomEngine, State,
+			                                     WritableOutput>;
+			result.op = plan_op::Class;
+			result.members = members_t::value;
+			result.member_count = members_t::size;
+			result.bound = class_bounded_size<JsonMember, member_list_t>::value;
+		} else if constexpr( member_is_parse_type_v<JsonMember,
+		                                            JsonParseTypes::Array> ) {
+			result.op = plan_op::Array;
+			result.length = &fns::template container_length<JsonMember>;
+			result.element =
+			  &plan_node_for<typename JsonMember::json_element_t, RandomEngine,
+			                 State, WritableOutput>::value;
+			result.segment = element_path_segment<JsonMember>( );
+			result.tracks_path = path_rules_inside_v<JsonMember>;
+		} else if constexpr( member_is_parse_type_v<JsonMember,
+		                                            JsonParseTypes::KeyValue> ) {
+			using key_type_t =
+			  daw::json::json_link_no_name<typename JsonMember::key_type_t>;
+			using value_type_t =
+			  daw::json::json_link_no_name<typename JsonMember::value_type_t>;
+			result.op = plan_op::KeyValue;
+			result.write = &fns::template write_key_value<key_type_t>;
+			result.length = &fns::template container_length<JsonMember>;
+			result.element =
+			  &plan_node_for<value_type_t, RandomEngine, State,
+			                 WritableOutput>::value;
+			result.segment = element_path_segment<JsonMember>( );
+			result.tracks_path = path_rules_inside_v<JsonMember>;
+		} else if constexpr( member_is_parse_type_v<JsonMember,
+		                                            JsonParseTypes::Null> ) {
+			result.op = plan_op::Null;
+			result.is_null = &fns::template is_null<JsonMember>;
+			result.element =
+			  &plan_node_for<typename JsonMember::member_type, RandomEngine, State,
+			                 WritableOutput>::value;
+		} else {
+			result.write = &fns::template write_value<JsonMember>;
+		}
+		return result;
+	}
+
+	template<typename JsonMember, typename RandomEngine, typename State,
+	         typename WritableOutput>
+	struct plan_node_for {
+		static constexpr plan_node<RandomEngine, State, WritableOutput> value =
+		  make_plan_node<JsonMember, RandomEngine, State, WritableOutput>( );
+	};
+
+	/// @brief Write the value of node, as value_writer of its json type does
+	template<typename RandomEngine, typename State, typename WritableOutput>
+	void run_plan( plan_node<RandomEngine, State, WritableOutput> const &node,
+	               RandomEngine &reng, State &state, WritableOutput &out ) {
+		switch( node.op ) {
+		case plan_op::Leaf:
+			node.write( reng, state, out );
+			return;
+		case plan_op::Null:
+			if( node.is_null( reng, state ) ) {
+				write_output( out, daw::string_view( "null" ) );
+			} else {
+				run_plan( *node.element, reng, state, out );
+			}
+			return;
+		case plan_op::Array:
+		case plan_op::KeyValue: {
+			auto const ary_size = node.length( reng, state );
+			auto const nesting = nesting_guard<State>( state );
+			auto const element_path =
+			  path_guard<State>( state, node.segment, node.tracks_path );
+			if( node.op == plan_op::Array ) {
+				write_elements( out, '[', ']', ary_size, [&] {
+					run_plan( *node.element, reng, state, out );
+				} );
+			} else {
+				write_elements( out, '{', '}', ary_size, [&] {
+					node.write( reng, state, out );
+					put_output( out, ':' );
+					run_plan( *node.element, reng, state, out );
+				} );
+			}
+			return;
+		}
+		case plan_op::Class: {
+			auto const nesting = nesting_guard<State>( state );
+			put_output( out, '{' );
+			bool const reserved = reserve_output( out, node.bound - 1U );
+			bool is_first = true;
+			auto const last = node.members + node.member_count;
+			for( auto member = node.members; member != last; ++member ) {
+				release_output( out, member->bound, reserved );
+				auto const member_path =
+				  path_guard<State>( state, member->name, member->tracks_path );
+				if( member->write_rule != nullptr and
+				    member->write_rule( reng, state, out, is_first ) ) {
+					continue;
+				}
+				auto const *value = member->node;
+				if( value->op == plan_op::Null and
+				    state.nulls == null_output::omit_member ) {
+					if( value->is_null( reng, state ) ) {
+						continue;
+					}
+					value = value->element;
+				}
+				write_member_name( out, is_first,
+				                   daw::string_view( member->name.data( ),
+				                                     member->name.size( ) ) );
+				run_plan( *value, reng, state, out );
+			}
+			release_output( out, 1, reserved );
+			put_output( out, '}' );
+			return;
+		}
+		}
+	}
+} // namespace daw::data_gen::datagen_details
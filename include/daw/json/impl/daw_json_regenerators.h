@@ -0,0 +1,361 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+
+#pragma once
+
+#include "../../data_faker/concepts/daw_writable_output.h"
+#include "daw_json_generators.h"
+
+#include <daw/daw_traits.h>
+#include <daw/json/daw_json_link.h>
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace daw::data_gen::datagen_details {
+	/// @brief Overwrites an existing value with a newly generated one, reusing
+	/// the memory it already owns.  Mirrors value_generator and draws from the
+	/// engine in the same order, so regenerating gives the value generating
+	/// would have from the same engine state.  This primary template assigns
+	/// a generated value, for scalars and types whose storage cannot be reused
+	template<typename JsonMember, typename = void,
+	         typename = std::enable_if_t<
+	           daw::json::json_details::is_a_json_type_v<JsonMember>>>
+	struct value_regenerator {
+		template<typename RandomEngine, typename State, typename T>
+		void operator( )( RandomEngine &reng, State &state, T &value ) const {
+			value = value_generator<JsonMember>{ }( reng, state );
+		}
+	};
+
+	template<typename JsonMember>
+	inline constexpr bool uses_default_constructor_v =
+	  std::is_same_v<typename JsonMember::constructor_t,
+	                 daw::json::default_constructor<
+	                   daw::json::json_details::json_result<JsonMember>>>;
+
+	/// @brief Strings are resized, keeping their capacity, and refilled.
+	/// Strings that are not ASCII are cleared and appended to
+	template<typename JsonMember>
+	struct value_regenerator<
+	  JsonMember,
+	  std::enable_if_t<member_is_parse_type_v<JsonMember,
+	                                          JsonParseTypes::StringEscaped> or
+	                   member_is_parse_type_v<JsonMember,
+	                                          JsonParseTypes::StringRaw>>> {
+		using type = typename JsonMember::parse_to_t;
+
+		template<typename RandomEngine, typename State>
+		void operator( )( RandomEngine &reng, State &state, type &value ) const {
+			if constexpr( concepts::writeable_output_details::
+			                is_resizable_contiguous_range_v<type, char> ) {
+				auto const len = gen_member_length<JsonMember>( reng );
+				auto const &profile = member_string_profile_policy<JsonMember>::value;
+				if( profile.is_ascii( ) ) {
+					value.resize( len );
+					fill_random_characters( reng, value.data( ), len );
+				} else {
+					value.clear( );
+					append_profile_characters( value, reng, profile, len );
+				}
+			} else {
+				value = value_generator<JsonMember>{ }( reng, state );
+			}
+		}
+	};
+
+	template<typename>
+	inline constexpr bool is_std_optional_v = false;
+
+	template<typename T>
+	inline constexpr bool is_std_optional_v<std::optional<T>> = true;
+
+	/// @brief An engaged std::optional regenerates its value in place
+	template<typename JsonMember>
+	struct value_regenerator<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                       JsonMember, JsonParseTypes::Null>>> {
+		using type = typename JsonMember::parse_to_t;
+
+		template<typename RandomEngine, typename State>
+		void operator( )( RandomEngine &reng, State &state, type &value ) const {
+			if constexpr( is_std_optional_v<type> and
+			              std::is_default_constructible_v<
+			                typename type::value_type> ) {
+				if( gen_is_null<JsonMember>( reng, state ) ) {
+					value.reset( );
+					return;
+				}
+				if( not value ) {
+					value.emplace( );
+				}
+				value_regenerator<typename JsonMember::member_type>{ }( reng, state,
+				                                                        *value );
+			} else {
+				value = value_generator<JsonMember>{ }( reng, state );
+			}
+		}
+	};
+
+	template<typename Container>
+	using resizable_sequence_test =
+	  decltype( std::declval<Container &>( ).resize( std::size_t{ } ),
+	            *std::begin( std::declval<Container &>( ) ) );
+
+	/// @brief Sequences with resize whose elements are real references, e.g.
+	/// std::vector but not std::vector<bool>
+	template<typename Container, typename Element, typename = void>
+	inline constexpr bool is_resizable_sequence_v = false;
+
+	template<typename Container, typename Element>
+	inline constexpr bool is_resizable_sequence_v<
+	  Container, Element, std::void_t<resizable_sequence_test<Container>>> =
+	  std::is_same_v<resizable_sequence_test<Container>, Element &> and
+	  std::is_default_constructible_v<Element>;
+
+	/// @brief Regenerate the elements of a sequence in place.  Sequences of
+	/// the same elements share it
+	template<typename JsonElement, typename RandomEngine, typename State,
+	         typename Container>
+	void regenerate_elements( RandomEngine &reng, State &state,
+	                          Container &value ) {
+		for( auto &element : value ) {
+			value_regenerator<JsonElement>{ }( reng, state, element );
+		}
+	}
+
+	/// @brief Arrays are resized, keeping their capacity, and their elements
+	/// regenerated in place
+	template<typename JsonMember>
+	struct value_regenerator<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                       JsonMember, JsonParseTypes::Array>>> {
+		using type = typename JsonMember::parse_to_t;
+		using element_t = typename JsonMember::json_element_t;
+
+		template<typename RandomEngine, typename State>
+		void operator( )( RandomEngine &reng, State &state, type &value ) const {
+			if constexpr( uses_default_constructor_v<JsonMember> and
+			              is_resizable_sequence_v<
+			                type, typename JsonMember::json_element_parse_to_t> ) {
+				value.resize( gen_container_length<JsonMember>( reng, state ) );
+				auto const nesting = nesting_guard<State>( state );
+				auto const element_path =
+				  path_guard<State>( state, array_element_segment,
+				                     path_rules_inside_v<JsonMember> );
+				regenerate_elements<element_t>( reng, state, value );
+			} else {
+				value = value_generator<JsonMember>{ }( reng, state );
+			}
+		}
+	};
+
+	template<typename Container>
+	using node_map_test =
+	  decltype( std::declval<Container &>( )
+	              .extract( std::declval<Container &>( ).begin( ) )
+	              .mapped( ),
+	            std::declval<Container &>( ).insert(
+	              std::declval<typename Container::node_type>( ) ) );
+
+	/// @brief Maps with node handles, e.g. std::map and std::unordered_map
+	template<typename Container>
+	inline constexpr bool is_node_map_v =
+	  daw::is_detected_v<node_map_test, Container>;
+
+	/// @brief Node handles kept between calls so the scratch storage is only
+	/// allocated once per thread.  It is always left empty, nodes never
+	/// outlive the call that extracted them
+	template<typename Node>
+	std::vector<Node> &node_scratch( ) {
+		static thread_local auto nodes = std::vector<Node>( );
+		return nodes;
+	}
+
+	/// @brief Regenerate value as size pairs, reusing its nodes.  Maps of the
+	/// same pairs share it
+	template<typename KeyMember, typename ValueMember, typename RandomEngine,
+	         typename State, typename Map>
+	void regenerate_map_nodes( RandomEngine &reng, State &state, Map &value,
+	                           std::size_t size ) {
+		using node_t = typename Map::node_type;
+		// Take the scratch so a map of the same type nested in this one cannot
+		// use it at the same time
+		auto nodes = std::move( node_scratch<node_t>( ) );
+		while( nodes.size( ) < size and not value.empty( ) ) {
+			nodes.push_back( value.extract( value.begin( ) ) );
+		}
+		value.clear( );
+		for( std::size_t n = 0; n < size; ++n ) {
+			if( nodes.empty( ) ) {
+				auto key = value_generator<KeyMember>{ }( reng, state );
+				value.emplace( std::move( key ),
+				               value_generator<ValueMember>{ }( reng, state ) );
+				continue;
+			}
+			auto node = std::move( nodes.back( ) );
+			nodes.pop_back( );
+			value_regenerator<KeyMember>{ }( reng, state, node.key( ) );
+			value_regenerator<ValueMember>{ }( reng, state, node.mapped( ) );
+			// Like constructing from a range, the first of equal keys wins
+			value.insert( std::move( node ) );
+		}
+		nodes.clear( );
+		node_scratch<node_t>( ) = std::move( nodes );
+	}
+
+	/// @brief Maps reuse the nodes of their existing elements, regenerating
+	/// the key and value of each in place before inserting it again
+	template<typename JsonMember>
+	struct value_regenerator<
+	  JsonMember,
+	  std::enable_if_t<
+	    member_is_parse_type_v<JsonMember, JsonParseTypes::KeyValue>>> {
+		using type = typename JsonMember::parse_to_t;
+		using key_type_t =
+		  daw::json::json_link_no_name<typename JsonMember::key_type_t>;
+		using value_type_t =
+		  daw::json::json_link_no_name<typename JsonMember::value_type_t>;
+
+		template<typename RandomEngine, typename State>
+		void operator( )( RandomEngine &reng, State &state, type &value ) const {
+			if constexpr( uses_default_constructor_v<JsonMember> and
+			              is_node_map_v<type> ) {
+				auto const size = gen_container_length<JsonMember>( reng, state );
+				auto const nesting = nesting_guard<State>( state );
+				auto const element_path =
+				  path_guard<State>( state, key_value_segment,
+				                     path_rules_inside_v<JsonMember> );
+				regenerate_map_nodes<key_type_t, value_type_t>( reng, state, value,
+				                                                size );
+			} else {
+				value = value_generator<JsonMember>{ }( reng, state );
+			}
+		}
+	};
+
+	/// @brief A to_json_data result element refers to the member itself
+	/// instead of holding a copy or a computed value
+	template<typename Element, typename JsonMember>
+	inline constexpr bool is_member_reference_v =
+	  std::is_lvalue_reference_v<Element> and
+	  std::is_same_v<std::remove_cv_t<std::remove_reference_t<Element>>,
+	                 typename daw::json::json_link_no_name<
+	                   JsonMember>::parse_to_t>;
+
+	template<typename T, typename... JsonMembers, std::size_t... Is>
+	constexpr bool member_references_test( std::index_sequence<Is...> ) {
+		using members_t = to_json_data_test<T>;
+		if constexpr( std::tuple_size_v<members_t> != sizeof...( JsonMembers ) ) {
+			return false;
+		} else {
+			return ( is_member_reference_v<std::tuple_element_t<Is, members_t>,
+			                               JsonMembers> and
+			         ... );
+		}
+	}
+
+	template<typename T, typename JsonMemberList, typename = void>
+	inline constexpr bool has_member_references_v = false;
+
+	template<typename T, template<typename...> typename MemberList,
+	         typename... JsonMembers>
+	inline constexpr bool has_member_references_v<
+	  T, MemberList<JsonMembers...>, std::void_t<to_json_data_test<T>>> =
+	  member_references_test<T, JsonMembers...>(
+	    std::index_sequence_for<JsonMembers...>{ } );
+
+	/// @brief Regenerate a class member in place, or with the first of its
+	/// member_path_rules that matches the path.  Tuple members have no name
+	/// and are always regenerated in place
+	template<template<typename...> typename MemberList, typename JsonMember,
+	         typename RandomEngine, typename State, typename T>
+	void regenerate_member( RandomEngine &reng, State &state, T &value ) {
+		using json_member = daw::json::json_link_no_name<JsonMember>;
+		if constexpr( not std::is_same_v<MemberList<>,
+		                                 daw::json::json_member_list<>> ) {
+			value_regenerator<json_member>{ }( reng, state, value );
+		} else {
+			auto const member_path =
+			  path_guard<State>( state, member_path_segment<JsonMember>( ),
+			                     path_rules_inside_v<JsonMember> );
+			if constexpr( has_member_path_rules_v<JsonMember> ) {
+				bool const matched =
+				  with_path_rule<JsonMember>( state, [&]( auto const &gen ) {
+					  value = gen_rule_value<json_member>( gen, reng );
+				  } );
+				if( matched ) {
+					return;
+				}
+			}
+			value_regenerator<json_member>{ }( reng, state, value );
+		}
+	}
+
+	template<typename, typename>
+	struct class_regenerator;
+
+	/// @brief Classes whose to_json_data refers to every member are
+	/// regenerated member by member, in order, through those references.
+	/// Classes with tagged variants choose the alternatives first and are
+	/// generated again, see tagged_class_generator
+	template<typename JsonMember, template<typename...> typename MemberList,
+	         typename... JsonMembers>
+	struct class_regenerator<JsonMember, MemberList<JsonMembers...>> {
+		using type = typename JsonMember::parse_to_t;
+
+		template<typename RandomEngine, typename State, std::size_t... Is>
+		static void regenerate_members( RandomEngine &reng, State &state,
+		                                type &value,
+		                                std::index_sequence<Is...> ) {
+			using contract_t = daw::json::json_data_contract<type>;
+			auto members = contract_t::to_json_data( std::as_const( value ) );
+			// value is not const, only the view to_json_data gives of it is
+			( regenerate_member<MemberList, JsonMembers>(
+			    reng, state,
+			    const_cast<std::remove_cv_t<std::remove_reference_t<
+			      std::tuple_element_t<Is, decltype( members )>>> &>(
+			      std::get<Is>( members ) ) ),
+			  ... );
+		}
+
+		template<typename RandomEngine, typename State>
+		void operator( )( RandomEngine &reng, State &state, type &value ) const {
+			static_assert( std::is_move_assignable_v<type>,
+			               "Only assignable types can be regenerated" );
+			if constexpr( uses_default_constructor_v<JsonMember> and
+			              std::is_same_v<type, typename JsonMember::base_type> and
+			              not has_tagged_variant_member_v<
+			                MemberList<JsonMembers...>> and
+			              has_member_references_v<
+			                type, MemberList<JsonMembers...>> ) {
+				auto const nesting = nesting_guard<State>( state );
+				regenerate_members( reng, state, value,
+				                    std::index_sequence_for<JsonMembers...>{ } );
+			} else {
+				value = value_generator<JsonMember>{ }( reng, state );
+			}
+		}
+	};
+
+	template<typename JsonMember>
+	struct value_regenerator<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                       JsonMember, JsonParseTypes::Class>>> {
+		using type = typename JsonMember::parse_to_t;
+
+		template<typename RandomEngine, typename State>
+		void operator( )( RandomEngine &reng, State &state, type &value ) const {
+			class_regenerator<JsonMember, daw::json::json_data_contract_trait_t<
+			                                typename JsonMember::base_type>>{ }(
+			  reng, state, value );
+		}
+	};
+} // namespace daw::data_gen::datagen_details
@@ -0,0 +1,121 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+
+#pragma once
+
+#include <daw/json/daw_json_link.h>
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace daw::data_gen {
+	/// @brief Tracks the estimated size of the minified JSON text of the value
+	/// being generated.  A target of 0 disables tracking
+	struct size_budget {
+		std::size_t target = 0;
+		std::size_t used = 0;
+		/// Set once an array or key value container has taken on growing the
+		/// document until the target is reached
+		bool expansion_claimed = false;
+
+		constexpr bool enabled( ) const {
+			return target != 0;
+		}
+
+		constexpr std::size_t remaining( ) const {
+			return used < target ? target - used : 0;
+		}
+
+		constexpr void add( std::size_t size ) {
+			used += size;
+		}
+	};
+} // namespace daw::data_gen
+
+namespace daw::data_gen::datagen_details {
+	constexpr bool needs_escaping( char c ) {
+		return c == '"' or c == '\\' or static_cast<unsigned char>( c ) < 0x20U;
+	}
+
+	/// @brief Size of c once escaped in a JSON string
+	constexpr std::size_t escaped_size( char c ) {
+		switch( c ) {
+		case '"':
+		case '\\':
+		case '\b':
+		case '\f':
+		case '\n':
+		case '\r':
+		case '\t':
+			return 2;
+		default:
+			return static_cast<unsigned char>( c ) < 0x20U ? 6 : 1;
+		}
+	}
+
+	/// @brief Size of str as a quoted and escaped JSON string
+	template<typename String>
+	constexpr std::size_t serialized_string_size( String const &str ) {
+		std::size_t result = 2;
+		for( char c : str ) {
+			result += escaped_size( c );
+		}
+		return result;
+	}
+
+	template<typename Integer, std::enable_if_t<std::is_integral_v<Integer>,
+	                                            std::nullptr_t> = nullptr>
+	constexpr std::size_t serialized_size( Integer value ) {
+		if constexpr( std::is_same_v<Integer, bool> ) {
+			return value ? 4 : 5;
+		} else {
+			using unsigned_t = std::make_unsigned_t<Integer>;
+			std::size_t result = 1;
+			auto uvalue = static_cast<unsigned_t>( value );
+			if constexpr( std::is_signed_v<Integer> ) {
+				if( value < 0 ) {
+					++result;
+					uvalue = static_cast<unsigned_t>( unsigned_t{ 0 } - uvalue );
+				}
+			}
+			while( uvalue >= 10U ) {
+				uvalue /= 10U;
+				++result;
+			}
+			return result;
+		}
+	}
+
+	inline constexpr std::size_t max_real_text_size = 32U;
+
+	/// @brief Write value to out, which has room for max_real_text_size
+	/// characters, with the formatter to_json uses.  Returns the end of the
+	/// text
+	template<typename Real>
+	char *write_real_text( char *out, Real value ) {
+		return daw::json::to_json( value, static_cast<char *>( out ) );
+	}
+
+	/// @brief Size of value as written by to_json and write_real
+	template<typename Real,
+	         std::enable_if_t<std::is_floating_point_v<Real>, std::nullptr_t> =
+	           nullptr>
+	std::size_t serialized_size( Real value ) {
+		char buff[max_real_text_size];
+		return static_cast<std::size_t>( write_real_text( buff, value ) - buff );
+	}
+
+	/// @brief Account for value in state's size budget, when enabled
+	template<typename State, typename T>
+	constexpr void add_serialized_size( State &state, T const &value ) {
+		if( state.budget.enabled( ) ) {
+			state.budget.add( serialized_size( value ) );
+		}
+	}
+} // namespace daw::data_gen::datagen_details
@@ -0,0 +1,1030 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+
+#pragma once
+
+#include "../../data_faker/concepts/daw_writable_output.h"
+#include "daw_json_generators.h"
+
+#include <daw/json/daw_json_link.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+namespace daw::data_gen::datagen_details {
+	/// @brief Writes the JSON text of a generated value straight to a
+	/// WritableOutput instead of building the value first.  Mirrors
+	/// value_generator, so each specialization only keeps the state needed for
+	/// the value currently being written
+	template<typename JsonMember, typename = void,
+	         typename = std::enable_if_t<
+	           daw::json::json_details::is_a_json_type_v<JsonMember>>>
+	struct value_writer;
+
+	template<typename WritableOutput>
+	void write_escaped_character( WritableOutput &out, char c ) {
+		switch( c ) {
+		case '"':
+			write_output( out, daw::string_view( "\\\"" ) );
+			return;
+		case '\\':
+			write_output( out, daw::string_view( "\\\\" ) );
+			return;
+		case '\b':
+			write_output( out, daw::string_view( "\\b" ) );
+			return;
+		case '\f':
+			write_output( out, daw::string_view( "\\f" ) );
+			return;
+		case '\n':
+			write_output( out, daw::string_view( "\\n" ) );
+			return;
+		case '\r':
+			write_output( out, daw::string_view( "\\r" ) );
+			return;
+		case '\t':
+			write_output( out, daw::string_view( "\\t" ) );
+			return;
+		default:
+			if( static_cast<unsigned char>( c ) < 0x20U ) {
+				constexpr char const hex[] = "0123456789ABCDEF";
+				char const buff[6] = {
+				  '\\', 'u', '0', '0', hex[( static_cast<unsigned char>( c ) >> 4U )],
+				  hex[static_cast<unsigned char>( c ) & 0xFU] };
+				write_output( out, daw::string_view( buff, 6 ) );
+				return;
+			}
+			put_output( out, c );
+		}
+	}
+
+	template<typename WritableOutput, typename Integer>
+	void write_integer( WritableOutput &out, Integer value ) {
+		char buff[24];
+		auto const result = std::to_chars( buff, buff + sizeof( buff ), value );
+		daw_json_ensure( result.ec == std::errc{ },
+		                 daw::json::ErrorReason::OutputError );
+		write_output( out,
+		              daw::string_view(
+		                buff, static_cast<std::size_t>( result.ptr - buff ) ) );
+	}
+
+	template<typename WritableOutput, typename Real>
+	void write_real( WritableOutput &out, Real value ) {
+		char buff[max_real_text_size];
+		auto const last = write_real_text( buff, value );
+		write_output( out, daw::string_view(
+		                     buff, static_cast<std::size_t>( last - buff ) ) );
+	}
+
+	/// @brief Write sv escaped, runs without escapes are written in one call
+	template<typename WritableOutput>
+	void write_escaped( WritableOutput &out, daw::string_view sv ) {
+		auto first = sv.data( );
+		auto const last = first + sv.size( );
+		while( first != last ) {
+			auto const run_last = std::find_if( first, last, needs_escaping );
+			if( run_last != first ) {
+				write_output( out, daw::string_view( first, static_cast<std::size_t>(
+				                                              run_last - first ) ) );
+			}
+			if( run_last == last ) {
+				return;
+			}
+			write_escaped_character( out, *run_last );
+			first = run_last + 1;
+		}
+	}
+
+	template<typename T>
+	using rewindable_output_test =
+	  decltype( std::declval<T &>( ).rewind( std::declval<T &>( ).checkpoint( ) ),
+	            (void)static_cast<bool>( std::declval<T &>( ).overflowed( ) ),
+	            std::declval<T &>( ).reserve( std::size_t{ 1 } ),
+	            std::declval<T &>( ).release( std::size_t{ 1 } ) );
+
+	/// @brief Outputs with a bounded size, such as bounded_buffer, that can
+	/// drop what was written after a checkpoint
+	template<typename T>
+	inline constexpr bool is_rewindable_output_v =
+	  daw::is_detected_v<rewindable_output_test, T>;
+
+	/// @brief Hold back count bytes on rewindable outputs, e.g. for a closing
+	/// bracket.  Returns whether they were reserved
+	template<typename WritableOutput>
+	constexpr bool reserve_output( WritableOutput &out, std::size_t count ) {
+		if constexpr( is_rewindable_output_v<WritableOutput> ) {
+			if( out.overflowed( ) ) {
+				return false;
+			}
+			out.reserve( count );
+			return not out.overflowed( );
+		} else {
+			(void)out;
+			(void)count;
+			return false;
+		}
+	}
+
+	template<typename WritableOutput>
+	constexpr void release_output( WritableOutput &out, std::size_t count,
+	                               bool reserved ) {
+		if constexpr( is_rewindable_output_v<WritableOutput> ) {
+			if( reserved ) {
+				out.release( count );
+			}
+		} else {
+			(void)out;
+			(void)count;
+			(void)reserved;
+		}
+	}
+
+	/// @brief Write a code point above U+007F as \uXXXX, or a surrogate pair
+	/// of them above U+FFFF
+	template<typename WritableOutput>
+	void write_unicode_escape( WritableOutput &out, std::uint32_t cp ) {
+		constexpr char const hex[] = "0123456789ABCDEF";
+		auto const write_unit = [&]( std::uint32_t unit ) {
+			char const buff[6] = { '\\',
+			                       'u',
+			                       hex[( unit >> 12U ) & 0xFU],
+			                       hex[( unit >> 8U ) & 0xFU],
+			                       hex[( unit >> 4U ) & 0xFU],
+			                       hex[unit & 0xFU] };
+			write_output( out, daw::string_view( buff, 6 ) );
+		};
+		if( cp < 0x10000U ) {
+			write_unit( cp );
+		} else {
+			cp -= 0x10000U;
+			write_unit( 0xD800U | ( cp >> 10U ) );
+			write_unit( 0xDC00U | ( cp & 0x3FFU ) );
+		}
+	}
+
+	/// @brief Write the valid UTF-8 in sv escaped, with the code points above
+	/// U+007F as \uXXXX escapes
+	template<typename WritableOutput>
+	void write_unicode_escaped( WritableOutput &out, daw::string_view sv ) {
+		auto first = sv.data( );
+		auto const last = first + sv.size( );
+		while( first != last ) {
+			auto const run_last = std::find_if( first, last, []( char c ) {
+				return static_cast<unsigned char>( c ) >= 0x80U;
+			} );
+			write_escaped( out, daw::string_view( first, static_cast<std::size_t>(
+			                                               run_last - first ) ) );
+			if( run_last == last ) {
+				return;
+			}
+			auto const lead = static_cast<unsigned char>( *run_last );
+			auto const size = lead >= 0xF0U ? 4U : lead >= 0xE0U ? 3U : 2U;
+			std::uint32_t cp = lead & ( 0x7FU >> size );
+			for( unsigned n = 1; n < size; ++n ) {
+				cp = ( cp << 6U ) |
+				     ( static_cast<unsigned char>( run_last[n] ) & 0x3FU );
+			}
+			write_unicode_escape( out, cp );
+			first = run_last + size;
+		}
+	}
+
+	/// @brief Stream a random string with the same length and characters as
+	/// gen_member_string, quoting and escaping as it goes.  Raw strings are
+	/// written unescaped, as to_json does
+	template<typename JsonMember, typename RandomEngine, typename WritableOutput>
+	void write_random_string( RandomEngine &reng, WritableOutput &out ) {
+		constexpr auto profile = member_string_profile_policy<JsonMember>::value;
+		constexpr bool escaped =
+		  member_is_parse_type_v<JsonMember, JsonParseTypes::StringEscaped>;
+		auto len = gen_member_length<JsonMember>( reng );
+		if constexpr( is_rewindable_output_v<WritableOutput> ) {
+			// Shorten strings that might not fit
+			constexpr auto char_size = max_serialized_char_size( profile, escaped );
+			auto const room = out.available( );
+			if( char_size * len + 2U > room ) {
+				len = room > 2U ? ( room - 2U ) / char_size : 0U;
+			}
+		}
+		put_output( out, '"' );
+		if constexpr( profile.is_ascii( ) ) {
+			char buff[random_character_block_size];
+			while( len > 0 ) {
+				auto const block_size = std::min( len, random_character_block_size );
+				fill_random_characters( reng, buff, block_size );
+				if constexpr( escaped ) {
+					write_escaped( out, daw::string_view( buff, block_size ) );
+				} else {
+					write_output( out, daw::string_view( buff, block_size ) );
+				}
+				len -= block_size;
+			}
+		} else {
+			char buff[random_character_block_size * max_profile_char_size];
+			while( len > 0 ) {
+				auto const block_size = std::min( len, random_character_block_size );
+				auto const text = daw::string_view(
+				  buff, fill_profile_characters( reng, profile, buff, block_size ) );
+				if constexpr( not escaped ) {
+					write_output( out, text );
+				} else if constexpr( profile.escape_unicode ) {
+					write_unicode_escaped( out, text );
+				} else {
+					write_escaped( out, text );
+				}
+				len -= block_size;
+			}
+		}
+		put_output( out, '"' );
+	}
+
+	template<typename JsonMember>
+	struct value_writer<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                  JsonMember, JsonParseTypes::Real>>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &state,
+		                  WritableOutput &out ) const {
+			write_real( out, value_generator<JsonMember>{ }( reng, state ) );
+		}
+	};
+
+	template<typename JsonMember>
+	struct value_writer<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                  JsonMember, JsonParseTypes::Signed>>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &state,
+		                  WritableOutput &out ) const {
+			write_integer( out, value_generator<JsonMember>{ }( reng, state ) );
+		}
+	};
+
+	template<typename JsonMember>
+	struct value_writer<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                  JsonMember, JsonParseTypes::Unsigned>>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &state,
+		                  WritableOutput &out ) const {
+			write_integer( out, value_generator<JsonMember>{ }( reng, state ) );
+		}
+	};
+
+	template<typename JsonMember>
+	struct value_writer<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                  JsonMember, JsonParseTypes::Bool>>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &state,
+		                  WritableOutput &out ) const {
+			if( static_cast<bool>( value_generator<JsonMember>{ }( reng, state ) ) ) {
+				write_output( out, daw::string_view( "true" ) );
+			} else {
+				write_output( out, daw::string_view( "false" ) );
+			}
+		}
+	};
+
+	template<typename JsonMember>
+	struct value_writer<JsonMember,
+	                    std::enable_if_t<member_is_parse_type_v<
+	                      JsonMember, JsonParseTypes::StringEscaped>>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &,
+		                  WritableOutput &out ) const {
+			write_random_string<JsonMember>( reng, out );
+		}
+	};
+
+	template<typename JsonMember>
+	struct value_writer<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                  JsonMember, JsonParseTypes::StringRaw>>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &,
+		                  WritableOutput &out ) const {
+			write_random_string<JsonMember>( reng, out );
+		}
+	};
+
+	template<typename JsonMember>
+	struct value_writer<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                  JsonMember, JsonParseTypes::Null>>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &state,
+		                  WritableOutput &out ) const {
+			if( gen_is_null<JsonMember>( reng, state ) ) {
+				write_output( out, daw::string_view( "null" ) );
+			} else {
+				value_writer<typename JsonMember::member_type>{ }( reng, state, out );
+			}
+		}
+	};
+
+	template<typename, typename, std::size_t = 0>
+	struct class_bounded_size;
+
+	/// @brief Nullable classes nested deeper than this in the bound of a
+	/// class count as null, so recursive data contracts have a bound
+	inline constexpr std::size_t max_bounded_nullable_depth = 4U;
+
+	template<typename JsonMember, std::size_t NullableDepth = 0>
+	constexpr std::size_t bounded_size( );
+
+	template<typename JsonMember, std::size_t NullableDepth, std::size_t... Is>
+	constexpr std::size_t variant_bounded_size( std::index_sequence<Is...> ) {
+		return std::max( { bounded_size<variant_element_t<JsonMember, Is>,
+		                                NullableDepth>( )... } );
+	}
+
+	/// @brief Upper bound of the size of JsonMember's JSON text when its
+	/// strings and containers are empty.  Rewindable outputs reserve it for
+	/// class members not yet written, so a container that is cut short leaves
+	/// room for the members after it.  A variant is bound by its largest
+	/// alternative and a custom member by its text generator, the tags of
+	/// tagged variants are counted by the class holding them.  Other custom
+	/// members cannot be bound and count as 0
+	template<typename JsonMember, std::size_t NullableDepth>
+	constexpr std::size_t bounded_size( ) {
+		using type = typename JsonMember::parse_to_t;
+		constexpr auto expected_type = JsonMember::expected_type;
+		if constexpr( expected_type == JsonParseTypes::Real ) {
+			// -2.2250738585072014e-308
+			return 24;
+		} else if constexpr( expected_type == JsonParseTypes::Signed or
+		                     expected_type == JsonParseTypes::Unsigned ) {
+			return static_cast<std::size_t>( std::numeric_limits<type>::digits10 ) +
+			       2U;
+		} else if constexpr( expected_type == JsonParseTypes::Bool ) {
+			return 5;
+		} else if constexpr( expected_type == JsonParseTypes::StringEscaped or
+		                     expected_type == JsonParseTypes::StringRaw or
+		                     expected_type == JsonParseTypes::Array or
+		                     expected_type == JsonParseTypes::KeyValue ) {
+			return 2;
+		} else if constexpr( expected_type == JsonParseTypes::Null ) {
+			if constexpr( NullableDepth >= max_bounded_nullable_depth ) {
+				return 4;
+			} else {
+				return std::max<std::size_t>(
+				  4, bounded_size<typename JsonMember::member_type,
+				                  NullableDepth + 1U>( ) );
+			}
+		} else if constexpr( expected_type == JsonParseTypes::Class ) {
+			return class_bounded_size<JsonMember,
+			                          daw::json::json_data_contract_trait_t<
+			                            typename JsonMember::base_type>,
+			                          NullableDepth>::value;
+		} else if constexpr( expected_type == JsonParseTypes::Date ) {
+			return date_text_size<JsonMember> + 2U;
+		} else if constexpr( expected_type == JsonParseTypes::Custom ) {
+			if constexpr( has_custom_text_generator<JsonMember>( ) ) {
+				return std::remove_cv_t<custom_value_generator_test<JsonMember>>::
+				         max_size +
+				       custom_quote_size<JsonMember>;
+			} else {
+				return 0;
+			}
+		} else if constexpr( expected_type == JsonParseTypes::Variant or
+		                     expected_type == JsonParseTypes::VariantTagged or
+		                     expected_type == JsonParseTypes::VariantIntrusive ) {
+			return variant_bounded_size<JsonMember, NullableDepth>(
+			  std::make_index_sequence<variant_size_v<JsonMember>>{ } );
+		} else {
+			return 0;
+		}
+	}
+
+	/// @brief The bound of a class member including its name and separator
+	template<typename JsonMember, std::size_t NullableDepth = 0>
+	constexpr std::size_t bounded_member_size( ) {
+		return daw::string_view( JsonMember::name ).size( ) + 4U +
+		       bounded_size<daw::json::json_link_no_name<JsonMember>,
+		                    NullableDepth>( );
+	}
+
+	template<typename JsonMember, std::size_t NullableDepth = 0>
+	constexpr std::size_t bounded_tuple_member_size( ) {
+		return 1U + bounded_size<daw::json::json_link_no_name<JsonMember>,
+		                         NullableDepth>( );
+	}
+
+	/// @brief The bound of the tag a class writes for member Index, see
+	/// class_variant_tags
+	template<typename Tags, typename JsonMember, std::size_t Index>
+	constexpr std::size_t bounded_tag_size( ) {
+		if constexpr( Tags::writes_tag( Index ) ) {
+			return bounded_member_size<typename JsonMember::tag_member>( );
+		} else {
+			return 0;
+		}
+	}
+
+	template<typename JsonMember, typename... JsonMembers, std::size_t... Is,
+	         std::size_t NullableDepth>
+	constexpr std::size_t
+	member_list_bounded_size( std::index_sequence<Is...>,
+	                          std::integral_constant<std::size_t, NullableDepth> ) {
+		using tags_t = class_variant_tags<JsonMembers...>;
+		return ( 2U + ... +
+		         ( bounded_tag_size<tags_t, JsonMembers, Is>( ) +
+		           bounded_member_size<JsonMembers, NullableDepth>( ) ) );
+	}
+
+	template<typename JsonMember, typename... JsonMembers,
+	         std::size_t NullableDepth>
+	struct class_bounded_size<
+	  JsonMember, daw::json::json_member_list<JsonMembers...>, NullableDepth> {
+		static constexpr std::size_t value =
+		  member_list_bounded_size<JsonMember, JsonMembers...>(
+		    std::index_sequence_for<JsonMembers...>{ },
+		    std::integral_constant<std::size_t, NullableDepth>{ } );
+	};
+
+	template<typename JsonMember, typename... JsonMembers,
+	         std::size_t NullableDepth>
+	struct class_bounded_size<JsonMember,
+	                          daw::json::json_tuple_member_list<JsonMembers...>,
+	                          NullableDepth> {
+		static constexpr std::size_t value =
+		  ( 2U + ... +
+		    bounded_tuple_member_size<JsonMembers, NullableDepth>( ) );
+	};
+
+	/// @brief Write count comma separated elements between open and close.  On
+	/// a rewindable output the first element that does not fit is dropped
+	/// along with the rest, so the container is cut short but stays valid
+	template<typename WritableOutput, typename WriteElement>
+	void write_elements( WritableOutput &out, char open, char close,
+	                     std::size_t count, WriteElement &&write_element ) {
+		put_output( out, open );
+		bool const reserved = reserve_output( out, 1 );
+		for( std::size_t n = 0; n < count; ++n ) {
+			if constexpr( is_rewindable_output_v<WritableOutput> ) {
+				if( not reserved ) {
+					break;
+				}
+				auto const checkpoint = out.checkpoint( );
+				if( n > 0 ) {
+					put_output( out, ',' );
+				}
+				write_element( );
+				if( out.overflowed( ) ) {
+					out.rewind( checkpoint );
+					break;
+				}
+			} else {
+				if( n > 0 ) {
+					put_output( out, ',' );
+				}
+				write_element( );
+			}
+		}
+		release_output( out, 1, reserved );
+		put_output( out, close );
+	}
+
+	/// @brief Writes an element of the arrays of JsonElement.  Arrays of the
+	/// same elements share it and the write_elements it is passed to
+	template<typename JsonElement, typename RandomEngine, typename State,
+	         typename WritableOutput>
+	struct array_element_writer {
+		RandomEngine &reng;
+		State &state;
+		WritableOutput &out;
+
+		void operator( )( ) const {
+			value_writer<JsonElement>{ }( reng, state, out );
+		}
+	};
+
+	template<typename JsonMember>
+	struct value_writer<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                  JsonMember, JsonParseTypes::Array>>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		DAW_ATTRIB_FLATTEN void operator( )( RandomEngine &reng, State &state,
+		                                     WritableOutput &out ) const {
+			auto const ary_size = gen_container_length<JsonMember>( reng, state );
+			auto const nesting = nesting_guard<State>( state );
+			auto const element_path =
+			  path_guard<State>( state, element_path_segment<JsonMember>( ),
+			                     path_rules_inside_v<JsonMember> );
+			write_elements(
+			  out, '[', ']', ary_size,
+			  array_element_writer<typename JsonMember::json_element_t,
+			                       RandomEngine, State, WritableOutput>{
+			    reng, state, out } );
+		}
+	};
+
+	/// @brief JSON object keys are always strings, numbers are quoted
+	template<typename JsonMember, typename RandomEngine, typename State,
+	         typename WritableOutput>
+	void write_key( RandomEngine &reng, State &state, WritableOutput &out ) {
+		constexpr auto key_type = JsonMember::expected_type;
+		if constexpr( key_type == JsonParseTypes::StringEscaped or
+		              key_type == JsonParseTypes::StringRaw ) {
+			value_writer<JsonMember>{ }( reng, state, out );
+		} else {
+			put_output( out, '"' );
+			value_writer<JsonMember>{ }( reng, state, out );
+			put_output( out, '"' );
+		}
+	}
+
+	/// @brief Writes a pair of the key value containers of KeyMember and
+	/// ValueMember, see array_element_writer
+	template<typename KeyMember, typename ValueMember, typename RandomEngine,
+	         typename State, typename WritableOutput>
+	struct key_value_pair_writer {
+		RandomEngine &reng;
+		State &state;
+		WritableOutput &out;
+
+		void operator( )( ) const {
+			write_key<KeyMember>( reng, state, out );
+			put_output( out, ':' );
+			value_writer<ValueMember>{ }( reng, state, out );
+		}
+	};
+
+	template<typename JsonMember>
+	struct value_writer<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                  JsonMember, JsonParseTypes::KeyValue>>> {
+		using key_type_t =
+		  daw::json::json_link_no_name<typename JsonMember::key_type_t>;
+		using value_type_t =
+		  daw::json::json_link_no_name<typename JsonMember::value_type_t>;
+
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		DAW_ATTRIB_FLATTEN void operator( )( RandomEngine &reng, State &state,
+		                                     WritableOutput &out ) const {
+			auto const ary_size = gen_container_length<JsonMember>( reng, state );
+			auto const nesting = nesting_guard<State>( state );
+			auto const element_path =
+			  path_guard<State>( state, element_path_segment<JsonMember>( ),
+			                     path_rules_inside_v<JsonMember> );
+			write_elements( out, '{', '}', ary_size,
+			                key_value_pair_writer<key_type_t, value_type_t,
+			                                      RandomEngine, State,
+			                                      WritableOutput>{ reng, state,
+			                                                       out } );
+		}
+	};
+
+	/// @brief Dates are written as ISO 8601 text without making a time_point
+	template<typename JsonMember>
+	struct value_writer<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                  JsonMember, JsonParseTypes::Date>>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &state,
+		                  WritableOutput &out ) const {
+			char buff[date_text_size<JsonMember>];
+			write_date_text<JsonMember>( buff,
+			                             gen_date_ms<JsonMember>( reng, state ) );
+			put_output( out, '"' );
+			write_output( out, daw::string_view( buff, std::size( buff ) ) );
+			put_output( out, '"' );
+		}
+	};
+
+	/// @brief Custom members with a text generator write its text.  Others have
+	/// no structure to walk, generate the value and let its to_converter
+	/// produce the text
+	template<typename JsonMember>
+	struct value_writer<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                  JsonMember, JsonParseTypes::Custom>>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &state,
+		                  WritableOutput &out ) const {
+			if constexpr( has_custom_text_generator<JsonMember>( ) ) {
+				constexpr auto const &gen = custom_value_generator<JsonMember>::value;
+				char buff[gen.max_size];
+				auto const last = gen( reng, buff );
+				auto const text = daw::string_view(
+				  buff, static_cast<std::size_t>( last - buff ) );
+				if constexpr( is_custom_literal<JsonMember>( ) ) {
+					write_output( out, text );
+				} else {
+					put_output( out, '"' );
+					write_output( out, text );
+					put_output( out, '"' );
+				}
+			} else {
+				auto const str = daw::json::to_json<JsonMember>(
+				  value_generator<JsonMember>{ }( reng, state ) );
+				write_output( out, daw::string_view( str.data( ), str.size( ) ) );
+			}
+		}
+	};
+
+	/// @brief Write alternative index of JsonMember's variant
+	template<typename JsonMember, typename RandomEngine, typename State,
+	         typename WritableOutput>
+	void write_variant_alternative( RandomEngine &reng, State &state,
+	                                WritableOutput &out, std::size_t index ) {
+		visit_index<0, variant_size_v<JsonMember>>( index, [&]( auto alternative ) {
+			using element_t =
+			  variant_element_t<JsonMember, decltype( alternative )::value>;
+			value_writer<element_t>{ }( reng, state, out );
+		} );
+	}
+
+	/// @brief Write the alternative chosen with the same draws as
+	/// value_generator, so writing and generating from a seed agree.  The tag
+	/// of a tagged variant is written by the class holding it, see
+	/// tagged_class_writer
+	template<typename JsonMember>
+	struct value_writer<
+	  JsonMember,
+	  std::enable_if_t<
+	    member_is_parse_type_v<JsonMember, JsonParseTypes::Variant> or
+	    member_is_parse_type_v<JsonMember, JsonParseTypes::VariantTagged>>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &state,
+		                  WritableOutput &out ) const {
+			write_variant_alternative<JsonMember>(
+			  reng, state, out, gen_variant_index<JsonMember>( reng ) );
+		}
+	};
+
+	/// @brief Write a tag as to_json does.  Tags are numbers, enums, strings
+	/// or bools, anything else is serialized with to_json
+	template<typename JsonMember, typename WritableOutput, typename Tag>
+	void write_tag_value( WritableOutput &out, Tag const &tag ) {
+		if constexpr( member_is_parse_type_v<JsonMember, JsonParseTypes::Signed> or
+		              member_is_parse_type_v<JsonMember,
+		                                     JsonParseTypes::Unsigned> ) {
+			if constexpr( std::is_enum_v<Tag> ) {
+				write_integer( out, static_cast<std::underlying_type_t<Tag>>( tag ) );
+			} else {
+				write_integer( out, tag );
+			}
+		} else if constexpr( member_is_parse_type_v<
+		                       JsonMember, JsonParseTypes::StringEscaped> ) {
+			put_output( out, '"' );
+			write_escaped( out, daw::string_view( std::data( tag ),
+			                                      std::size( tag ) ) );
+			put_output( out, '"' );
+		} else if constexpr( member_is_parse_type_v<JsonMember,
+		                                            JsonParseTypes::StringRaw> ) {
+			put_output( out, '"' );
+			write_output( out,
+			              daw::string_view( std::data( tag ), std::size( tag ) ) );
+			put_output( out, '"' );
+		} else if constexpr( member_is_parse_type_v<JsonMember,
+		                                            JsonParseTypes::Bool> ) {
+			write_output( out, static_cast<bool>( tag )
+			                     ? daw::string_view( "true" )
+			                     : daw::string_view( "false" ) );
+		} else {
+			auto const str = daw::json::to_json<JsonMember>( tag );
+			write_output( out, daw::string_view( str.data( ), str.size( ) ) );
+		}
+	}
+
+	template<typename WritableOutput>
+	void write_member_name( WritableOutput &out, bool &is_first,
+	                        daw::string_view name ) {
+		if( not is_first ) {
+			put_output( out, ',' );
+		}
+		is_first = false;
+		put_output( out, '"' );
+		write_output( out, name );
+		write_output( out, daw::string_view( "\":" ) );
+	}
+
+	template<typename JsonMember, typename WritableOutput>
+	void write_member_name( WritableOutput &out, bool &is_first ) {
+		write_member_name( out, is_first, daw::string_view( JsonMember::name ) );
+	}
+
+	/// @brief Write a member whose path_rule matches the current path,
+	/// generated and then serialized.  Returns whether one did
+	template<typename JsonMember, typename RandomEngine, typename State,
+	         typename WritableOutput>
+	bool write_path_rule_member( RandomEngine &reng, State &state,
+	                             WritableOutput &out, bool &is_first ) {
+		using json_member = daw::json::json_link_no_name<JsonMember>;
+		return with_path_rule<JsonMember>( state, [&]( auto const &gen ) {
+			auto const str = daw::json::to_json<json_member>(
+			  gen_rule_value<json_member>( gen, reng ) );
+			write_member_name<JsonMember>( out, is_first );
+			write_output( out, daw::string_view( str.data( ), str.size( ) ) );
+		} );
+	}
+
+	/// @brief Write a class member.  With null_output::omit_member a null
+	/// member is left out, so is_first stays set until a member is written.
+	/// Members with a matching path_rule are generated and then serialized
+	template<typename JsonMember, typename RandomEngine, typename State,
+	         typename WritableOutput>
+	void write_json_member( RandomEngine &reng, State &state,
+	                        WritableOutput &out, bool &is_first,
+	                        bool reserved ) {
+		using json_member = daw::json::json_link_no_name<JsonMember>;
+		release_output( out, bounded_member_size<JsonMember>( ), reserved );
+		auto const member_path =
+		  path_guard<State>( state, member_path_segment<JsonMember>( ),
+		                     path_rules_inside_v<JsonMember> );
+		if constexpr( has_member_path_rules_v<JsonMember> ) {
+			if( write_path_rule_member<JsonMember>( reng, state, out, is_first ) ) {
+				return;
+			}
+		}
+		if constexpr( member_is_parse_type_v<json_member, JsonParseTypes::Null> ) {
+			if( state.nulls == null_output::omit_member ) {
+				if( gen_is_null<json_member>( reng, state ) ) {
+					return;
+				}
+				write_member_name<JsonMember>( out, is_first );
+				value_writer<typename json_member::member_type>{ }( reng, state,
+				                                                    out );
+				return;
+			}
+		}
+		write_member_name<JsonMember>( out, is_first );
+		value_writer<json_member>{ }( reng, state, out );
+	}
+
+	template<typename JsonMember, typename RandomEngine, typename State,
+	         typename WritableOutput>
+	void write_json_tuple_member( RandomEngine &reng, State &state,
+	                              WritableOutput &out, bool is_first,
+	                              bool reserved ) {
+		release_output( out, bounded_tuple_member_size<JsonMember>( ),
+		                reserved );
+		if( not is_first ) {
+			put_output( out, ',' );
+		}
+		value_writer<daw::json::json_link_no_name<JsonMember>>{ }( reng, state,
+		                                                           out );
+	}
+
+	template<typename, typename>
+	struct class_writer;
+
+	template<typename JsonMember, typename... JsonMembers>
+	struct class_writer<JsonMember, daw::json::json_member_list<JsonMembers...>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &state,
+		                  WritableOutput &out ) const {
+			put_output( out, '{' );
+			// Room for the closing brace and each member's bound, released as
+			// they are written
+			bool const reserved = reserve_output(
+			  out, class_bounded_size<JsonMember,
+			                          daw::json::json_member_list<JsonMembers...>>::
+			           value -
+			         1U );
+			bool is_first = true;
+			(void)is_first;
+			( write_json_member<JsonMembers>( reng, state, out, is_first,
+			                                  reserved ),
+			  ... );
+			release_output( out, 1, reserved );
+			put_output( out, '}' );
+		}
+	};
+
+	template<typename JsonMember, typename... JsonMembers>
+	struct class_writer<JsonMember,
+	                    daw::json::json_tuple_member_list<JsonMembers...>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &state,
+		                  WritableOutput &out ) const {
+			put_output( out, '[' );
+			bool const reserved = reserve_output(
+			  out, class_bounded_size<
+			         JsonMember,
+			         daw::json::json_tuple_member_list<JsonMembers...>>::value -
+			         1U );
+			std::size_t pos = 0;
+			(void)pos;
+			( write_json_tuple_member<JsonMembers>( reng, state, out, pos++ == 0,
+			                                        reserved ),
+			  ... );
+			release_output( out, 1, reserved );
+			put_output( out, ']' );
+		}
+	};
+
+	/// @brief Whether the tags of every tagged variant of MemberList come from
+	/// variant_tag_values, so its class can be streamed
+	template<typename>
+	inline constexpr bool has_streamed_tags_v = false;
+
+	template<typename... JsonMembers>
+	inline constexpr bool
+	  has_streamed_tags_v<daw::json::json_member_list<JsonMembers...>> =
+	    ( ( not member_is_parse_type_v<JsonMembers,
+	                                   JsonParseTypes::VariantTagged> or
+	        has_variant_tag_values_v<
+	          daw::json::json_link_no_name<JsonMembers>> ) and
+	      ... );
+
+	/// @brief Write the tag of member Index of a class with the alternative
+	/// chosen for it, when the class writes one for it
+	template<typename Tags, typename JsonMember, std::size_t Index,
+	         typename WritableOutput>
+	void write_class_tag( WritableOutput &out, bool &is_first, bool reserved,
+	                      std::size_t alternative ) {
+		if constexpr( Tags::writes_tag( Index ) ) {
+			using tag_member_t = typename JsonMember::tag_member;
+			release_output( out, bounded_member_size<tag_member_t>( ), reserved );
+			write_member_name<tag_member_t>( out, is_first );
+			write_tag_value<daw::json::json_link_no_name<tag_member_t>>(
+			  out, variant_tag<daw::json::json_link_no_name<JsonMember>>(
+			         alternative ) );
+		} else {
+			(void)out;
+			(void)is_first;
+			(void)reserved;
+			(void)alternative;
+		}
+	}
+
+	/// @brief Write a member of a class holding tagged variants.  Tagged
+	/// variants write the alternative chosen up front.  to_json leaves out
+	/// members named like a tag, they are still generated to keep the draws
+	/// of tagged_class_generator
+	template<typename Tags, typename JsonMember, typename RandomEngine,
+	         typename State, typename WritableOutput>
+	void write_tagged_class_member( RandomEngine &reng, State &state,
+	                                WritableOutput &out, bool &is_first,
+	                                bool reserved, std::size_t alternative ) {
+		if constexpr( member_is_parse_type_v<JsonMember,
+		                                     JsonParseTypes::VariantTagged> ) {
+			release_output( out, bounded_member_size<JsonMember>( ), reserved );
+			auto const member_path =
+			  path_guard<State>( state, member_path_segment<JsonMember>( ),
+			                     path_rules_inside_v<JsonMember> );
+			write_member_name<JsonMember>( out, is_first );
+			write_variant_alternative<daw::json::json_link_no_name<JsonMember>>(
+			  reng, state, out, alternative );
+		} else if constexpr( Tags::is_tag(
+		                       daw::string_view( JsonMember::name ) ) ) {
+			release_output( out, bounded_member_size<JsonMember>( ), reserved );
+			(void)visit_json_member<JsonMember>( reng, state );
+		} else {
+			write_json_member<JsonMember>( reng, state, out, is_first, reserved );
+		}
+	}
+
+	template<typename, typename>
+	struct tagged_class_writer;
+
+	/// @brief Writes a class holding tagged variants as to_json does, their
+	/// tags first and then the members.  The alternatives are chosen first,
+	/// with the draws of tagged_class_generator, and each tag is taken from
+	/// variant_tag_values
+	template<typename JsonMember, typename... JsonMembers>
+	struct tagged_class_writer<JsonMember,
+	                           daw::json::json_member_list<JsonMembers...>> {
+		using tags_t = class_variant_tags<JsonMembers...>;
+
+		template<typename RandomEngine, typename State, typename WritableOutput,
+		         std::size_t... Is>
+		static void
+		write_members( RandomEngine &reng, State &state, WritableOutput &out,
+		               std::array<std::size_t, sizeof...( JsonMembers )> const
+		                 &alternatives,
+		               std::index_sequence<Is...> ) {
+			put_output( out, '{' );
+			bool const reserved = reserve_output(
+			  out, class_bounded_size<JsonMember,
+			                          daw::json::json_member_list<JsonMembers...>>::
+			           value -
+			         1U );
+			bool is_first = true;
+			( write_class_tag<tags_t, JsonMembers, Is>( out, is_first, reserved,
+			                                            alternatives[Is] ),
+			  ... );
+			( write_tagged_class_member<tags_t, JsonMembers>(
+			    reng, state, out, is_first, reserved, alternatives[Is] ),
+			  ... );
+			release_output( out, 1, reserved );
+			put_output( out, '}' );
+		}
+
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &state,
+		                  WritableOutput &out ) const {
+			// Braced initialization draws in member order
+			auto const alternatives =
+			  std::array<std::size_t, sizeof...( JsonMembers )>{
+			    gen_tagged_variant_index<JsonMembers>( reng )... };
+			write_members( reng, state, out, alternatives,
+			               std::index_sequence_for<JsonMembers...>{ } );
+		}
+	};
+
+	/// @brief Classes holding tagged variants with variant_tag_values are
+	/// written by tagged_class_writer.  Without them the tags are only known
+	/// to the switcher, those classes are generated and then serialized with
+	/// to_json, into a temporary string.  The rest are written as they are
+	/// generated
+	template<typename JsonMember>
+	struct value_writer<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                  JsonMember, JsonParseTypes::Class>>> {
+		using member_list_t =
+		  daw::json::json_data_contract_trait_t<typename JsonMember::base_type>;
+
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		DAW_ATTRIB_FLATTEN void operator( )( RandomEngine &reng, State &state,
+		                                     WritableOutput &out ) const {
+			if constexpr( not has_tagged_variant_member_v<member_list_t> ) {
+				auto const nesting = nesting_guard<State>( state );
+				class_writer<JsonMember, member_list_t>{ }( reng, state, out );
+			} else if constexpr( has_streamed_tags_v<member_list_t> ) {
+				auto const nesting = nesting_guard<State>( state );
+				tagged_class_writer<JsonMember, member_list_t>{ }( reng, state, out );
+			} else {
+				auto const str = daw::json::to_json<JsonMember>(
+				  value_generator<JsonMember>{ }( reng, state ) );
+				write_output( out, daw::string_view( str.data( ), str.size( ) ) );
+			}
+		}
+	};
+
+	/// @brief Write a member of an intrusive variant's alternative, the one
+	/// named like the variant's tag member is the tag, see
+	/// visit_intrusive_member
+	template<typename JsonMember, typename TagMember, typename RandomEngine,
+	         typename State, typename WritableOutput, typename Tag>
+	void write_intrusive_member( RandomEngine &reng, State &state,
+	                             WritableOutput &out, bool &is_first,
+	                             bool reserved, Tag const &tag ) {
+		if constexpr( same_member_name<JsonMember, TagMember>( ) ) {
+			using json_member = daw::json::json_link_no_name<JsonMember>;
+			using member_t = typename json_member::parse_to_t;
+			release_output( out, bounded_member_size<JsonMember>( ), reserved );
+			write_member_name<JsonMember>( out, is_first );
+			write_tag_value<json_member>( out, member_t( tag ) );
+		} else {
+			(void)tag;
+			write_json_member<JsonMember>( reng, state, out, is_first, reserved );
+		}
+	}
+
+	template<typename, typename, typename>
+	struct intrusive_alternative_writer;
+
+	/// @brief Writes an intrusive variant's alternative with the draws of
+	/// intrusive_alternative_generator
+	template<typename JsonMember, typename TagMember, typename... JsonMembers>
+	struct intrusive_alternative_writer<
+	  JsonMember, TagMember, daw::json::json_member_list<JsonMembers...>> {
+		template<typename RandomEngine, typename State, typename WritableOutput,
+		         typename Tag>
+		void operator( )( RandomEngine &reng, State &state, WritableOutput &out,
+		                  Tag const &tag ) const {
+			auto const nesting = nesting_guard<State>( state );
+			put_output( out, '{' );
+			bool const reserved = reserve_output(
+			  out, class_bounded_size<JsonMember,
+			                          daw::json::json_member_list<JsonMembers...>>::
+			           value -
+			         1U );
+			bool is_first = true;
+			( write_intrusive_member<JsonMembers, TagMember>(
+			    reng, state, out, is_first, reserved, tag ),
+			  ... );
+			release_output( out, 1, reserved );
+			put_output( out, '}' );
+		}
+	};
+
+	/// @brief Write the alternative of an intrusive variant chosen with the
+	/// draws of value_generator, its tag member from variant_tag_values
+	template<typename JsonMember>
+	struct value_writer<JsonMember, std::enable_if_t<member_is_parse_type_v<
+	                                  JsonMember,
+	                                  JsonParseTypes::VariantIntrusive>>> {
+		template<typename RandomEngine, typename State, typename WritableOutput>
+		void operator( )( RandomEngine &reng, State &state,
+		                  WritableOutput &out ) const {
+			using tag_member_t = typename JsonMember::tag_member;
+			visit_index<0, variant_size_v<JsonMember>>(
+			  gen_variant_index<JsonMember>( reng ), [&]( auto index ) {
+				  constexpr auto alternative_index = decltype( index )::value;
+				  using element_t = variant_element_t<JsonMember, alternative_index>;
+				  using member_list_t = daw::json::json_data_contract_trait_t<
+				    typename element_t::base_type>;
+				  intrusive_alternative_writer<element_t, tag_member_t,
+				                               member_list_t>{ }(
+				    reng, state, out, variant_tag<JsonMember>( alternative_index ) );
+			  } );
+		}
+	};
+} // namespace daw::data_gen::datagen_details
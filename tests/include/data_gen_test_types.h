@@ -0,0 +1,76 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_json_link_data_gen
+//
+// Small schemas shared by the tests and benchmarks.  Foo is a flat class and
+// Bar covers every basic member type, a nullable, arrays and a nested class
+
+#pragma once
+
+#include <daw/json/daw_json_link.h>
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+struct Foo {
+	int x;
+	std::string y;
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<Foo> {
+		static constexpr char const x[] = "x";
+		static constexpr char const y[] = "y";
+
+		using type = json_member_list<json_number<x, int>, json_string<y>>;
+
+		static auto to_json_data( Foo const &f ) {
+			return std::forward_as_tuple( f.x, f.y );
+		}
+	};
+} // namespace daw::json
+
+struct Bar {
+	std::optional<signed> osig;
+	signed sig;
+	unsigned unsig;
+	double real;
+	bool b;
+	std::string str;
+	std::vector<int> v;
+	Foo c;
+	std::vector<Foo> cv;
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<Bar> {
+		static constexpr char const osig[] = "osig";
+		static constexpr char const sig[] = "sig";
+		static constexpr char const unsig[] = "unsig";
+		static constexpr char const real[] = "real";
+		static constexpr char const b[] = "b";
+		static constexpr char const str[] = "str";
+		static constexpr char const v[] = "v";
+		static constexpr char const c[] = "c";
+		static constexpr char const cv[] = "cv";
+
+		using type =
+		  json_member_list<json_number_null<osig, std::optional<signed>>,
+		                   json_number<sig, signed>, json_number<unsig, unsigned>,
+		                   json_number<real>, json_bool<b>, json_string<str>,
+		                   json_array<v, int>, json_class<c, Foo>,
+		                   json_array<cv, Foo>>;
+
+		static auto to_json_data( Bar const &b ) {
+			return std::forward_as_tuple( b.osig, b.sig, b.unsig, b.real, b.b, b.str,
+			                              b.v, b.c, b.cv );
+		}
+	};
+} // namespace daw::json
@@ -7,76 +7,752 @@
 //
 
 #include "citm_test_json.h"
+#include "data_gen_test_types.h"
 #include "geojson_json.h"
 #include "twitter_test_json.h"
 
 #include <daw/daw_do_not_optimize.h>
+#include <daw/json/daw_json_link_corpus_gen.h>
 #include <daw/json/daw_json_link_data_gen.h>
+#include <daw/json/daw_json_link_data_generator.h>
+#include <daw/json/daw_json_link_parse_bench.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <memory_resource>
 #include <optional>
 #include <ostream>
+#include <random>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <variant>
 #include <vector>
 
-struct Foo {
+struct ArenaFoo {
 	int x;
-	std::string y;
+	std::pmr::string y;
+};
+
+struct ArenaBar {
+	std::pmr::vector<ArenaFoo> foos;
+	std::pmr::map<std::pmr::string, std::pmr::string> names;
 };
 
 namespace daw::json {
 	template<>
-	struct json_data_contract<Foo> {
+	struct json_data_contract<ArenaFoo> {
 		static constexpr char const x[] = "x";
 		static constexpr char const y[] = "y";
 
-		using type = json_member_list<json_number<x, int>, json_string<y>>;
+		using type =
+		  json_member_list<json_number<x, int>, json_string<y, std::pmr::string>>;
 
-		static auto to_json_data( Foo const &f ) {
+		static auto to_json_data( ArenaFoo const &f ) {
 			return std::forward_as_tuple( f.x, f.y );
 		}
 	};
+
+	template<>
+	struct json_data_contract<ArenaBar> {
+		static constexpr char const foos[] = "foos";
+		static constexpr char const names[] = "names";
+
+		using type = json_member_list<
+		  json_array<foos, ArenaFoo, std::pmr::vector<ArenaFoo>>,
+		  json_key_value<names, std::pmr::map<std::pmr::string, std::pmr::string>,
+		                 json_string_no_name<std::pmr::string>,
+		                 json_string_no_name<std::pmr::string>>>;
+
+		static auto to_json_data( ArenaBar const &b ) {
+			return std::forward_as_tuple( b.foos, b.names );
+		}
+	};
 } // namespace daw::json
 
-struct Bar {
-	std::optional<signed> osig;
-	signed sig;
-	unsigned unsig;
-	double real;
-	bool b;
-	std::string str;
-	std::vector<int> v;
-	Foo c;
-	std::vector<Foo> cv;
+struct Lengths {
+	std::string fixed_str;
+	std::vector<int> fixed_ary;
+	std::vector<int> ranged_ary;
 };
 
 namespace daw::json {
 	template<>
-	struct json_data_contract<Bar> {
-		static constexpr char const osig[] = "osig";
-		static constexpr char const sig[] = "sig";
-		static constexpr char const unsig[] = "unsig";
-		static constexpr char const real[] = "real";
-		static constexpr char const b[] = "b";
-		static constexpr char const str[] = "str";
-		static constexpr char const v[] = "v";
-		static constexpr char const c[] = "c";
-		static constexpr char const cv[] = "cv";
+	struct json_data_contract<Lengths> {
+		static constexpr char const fixed_str[] = "fixed_str";
+		static constexpr char const fixed_ary[] = "fixed_ary";
+		static constexpr char const ranged_ary[] = "ranged_ary";
 
 		using type =
-		  json_member_list<json_number_null<osig, std::optional<signed>>,
-		                   json_number<sig, signed>, json_number<unsig, unsigned>,
-		                   json_number<real>, json_bool<b>, json_string<str>,
-		                   json_array<v, int>, json_class<c, Foo>,
-		                   json_array<cv, Foo>>;
+		  json_member_list<json_string<fixed_str>, json_array<fixed_ary, int>,
+		                   json_array<ranged_ary, int>>;
+
+		static auto to_json_data( Lengths const &l ) {
+			return std::forward_as_tuple( l.fixed_str, l.fixed_ary, l.ranged_ary );
+		}
+	};
+} // namespace daw::json
+
+namespace daw::data_gen {
+	template<>
+	struct member_length_policy<daw::json::json_string<
+	  daw::json::json_data_contract<Lengths>::fixed_str>> {
+		static constexpr auto value = fixed_length{ 17 };
+	};
+
+	template<>
+	struct member_length_policy<daw::json::json_array<
+	  daw::json::json_data_contract<Lengths>::fixed_ary, int>> {
+		static constexpr auto value = fixed_length{ 1000 };
+	};
+
+	template<>
+	struct member_length_policy<daw::json::json_array<
+	  daw::json::json_data_contract<Lengths>::ranged_ary, int>> {
+		static constexpr auto value = histogram_length{
+		  histogram_bucket{ 2, 4, 1 }, histogram_bucket{ 8, 8, 1 } };
+	};
+} // namespace daw::data_gen
+
+struct Circle {
+	double radius;
+};
+
+struct Square {
+	double side;
+};
+
+struct Shapes {
+	std::variant<int, std::string, bool> label;
+	std::variant<Circle, Square> shape;
+};
+
+/// @brief Maps the "kind" tag to the alternative of Shapes::shape and back
+struct ShapeSwitcher {
+	std::size_t operator( )( int kind ) const {
+		return static_cast<std::size_t>( kind );
+	}
+
+	int operator( )( std::variant<Circle, Square> const &shape ) const {
+		return static_cast<int>( shape.index( ) );
+	}
+
+	int operator( )( Shapes const &s ) const {
+		return ( *this )( s.shape );
+	}
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<Circle> {
+		static constexpr char const radius[] = "radius";
+
+		using type = json_member_list<json_number<radius>>;
+
+		static auto to_json_data( Circle const &c ) {
+			return std::forward_as_tuple( c.radius );
+		}
+	};
+
+	template<>
+	struct json_data_contract<Square> {
+		static constexpr char const side[] = "side";
+
+		using type = json_member_list<json_number<side>>;
+
+		static auto to_json_data( Square const &s ) {
+			return std::forward_as_tuple( s.side );
+		}
+	};
+
+	template<>
+	struct json_data_contract<Shapes> {
+		static constexpr char const label[] = "label";
+		static constexpr char const kind[] = "kind";
+		static constexpr char const shape[] = "shape";
 
-		static auto to_json_data( Bar const &b ) {
-			return std::forward_as_tuple( b.osig, b.sig, b.unsig, b.real, b.b, b.str,
-			                              b.v, b.c, b.cv );
+		using label_t =
+		  json_variant<label, std::variant<int, std::string, bool>,
+		               json_variant_type_list<int, std::string, bool>>;
+		using shape_t =
+		  json_tagged_variant<shape, std::variant<Circle, Square>,
+		                      json_number<kind, int>, ShapeSwitcher,
+		                      json_tagged_variant_type_list<Circle, Square>>;
+
+		using type = json_member_list<label_t, shape_t>;
+
+		static auto to_json_data( Shapes const &s ) {
+			return std::forward_as_tuple( s.label, s.shape );
+		}
+	};
+} // namespace daw::json
+
+namespace daw::data_gen {
+	template<>
+	struct variant_weights<daw::json::json_data_contract<Shapes>::label_t> {
+		static constexpr std::array<unsigned, 3> value = { 0, 1, 3 };
+	};
+
+	template<>
+	struct variant_tag_values<daw::json::json_data_contract<Shapes>::shape_t> {
+		static constexpr std::array<int, 2> value = { 0, 1 };
+	};
+} // namespace daw::data_gen
+
+/// @brief Alternatives of an intrusive variant, each holds its own tag
+struct Dog {
+	int kind;
+	std::string name;
+};
+
+struct Cat {
+	int kind;
+	bool indoor;
+};
+
+struct Pets {
+	std::variant<Dog, Cat> pet;
+};
+
+struct PetSwitcher {
+	std::size_t operator( )( int kind ) const {
+		return static_cast<std::size_t>( kind - 1 );
+	}
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<Dog> {
+		static constexpr char const kind[] = "kind";
+		static constexpr char const name[] = "name";
+
+		using type = json_member_list<json_number<kind, int>, json_string<name>>;
+
+		static auto to_json_data( Dog const &d ) {
+			return std::forward_as_tuple( d.kind, d.name );
+		}
+	};
+
+	template<>
+	struct json_data_contract<Cat> {
+		static constexpr char const kind[] = "kind";
+		static constexpr char const indoor[] = "indoor";
+
+		using type = json_member_list<json_number<kind, int>, json_bool<indoor>>;
+
+		static auto to_json_data( Cat const &c ) {
+			return std::forward_as_tuple( c.kind, c.indoor );
+		}
+	};
+
+	template<>
+	struct json_data_contract<Pets> {
+		static constexpr char const kind[] = "kind";
+		static constexpr char const pet[] = "pet";
+
+		using pet_t =
+		  json_intrusive_variant<pet, std::variant<Dog, Cat>,
+		                         json_number<kind, int>, PetSwitcher,
+		                         json_tagged_variant_type_list<Dog, Cat>>;
+
+		using type = json_member_list<pet_t>;
+
+		static auto to_json_data( Pets const &p ) {
+			return std::forward_as_tuple( p.pet );
 		}
 	};
 } // namespace daw::json
 
+namespace daw::data_gen {
+	template<>
+	struct variant_tag_values<daw::json::json_data_contract<Pets>::pet_t> {
+		static constexpr std::array<int, 2> value = { 1, 2 };
+	};
+} // namespace daw::data_gen
+
+/// @brief Values kept as the text they were parsed from, like a timestamp or
+/// decimal type that formats itself
+struct TextValue {
+	std::string text;
+};
+
+struct TextValueConverter {
+	TextValue operator( )( std::string_view sv ) const {
+		return TextValue{ std::string( sv ) };
+	}
+
+	std::string operator( )( TextValue const &v ) const {
+		return v.text;
+	}
+};
+
+struct Order {
+	TextValue id;
+	TextValue placed;
+	TextValue price;
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<Order> {
+		static constexpr char const id[] = "id";
+		static constexpr char const placed[] = "placed";
+		static constexpr char const price[] = "price";
+
+		using placed_t =
+		  json_custom<placed, TextValue, TextValueConverter, TextValueConverter>;
+		using price_t =
+		  json_custom<price, TextValue, TextValueConverter, TextValueConverter>;
+
+		using type = json_member_list<
+		  json_custom<id, TextValue, TextValueConverter, TextValueConverter>,
+		  placed_t, price_t>;
+
+		static auto to_json_data( Order const &o ) {
+			return std::forward_as_tuple( o.id, o.placed, o.price );
+		}
+	};
+} // namespace daw::json
+
+namespace daw::data_gen {
+	template<>
+	struct custom_type_generator<TextValue> {
+		static constexpr auto value = uuid_text{ };
+	};
+
+	template<>
+	struct custom_value_generator<
+	  daw::json::json_data_contract<Order>::placed_t> {
+		static constexpr auto value = iso8601_text{ };
+	};
+
+	template<>
+	struct custom_value_generator<daw::json::json_data_contract<Order>::price_t> {
+		static constexpr auto value = decimal_text{ 1, 99, 2 };
+	};
+} // namespace daw::data_gen
+
+using timestamp_t = std::chrono::time_point<std::chrono::system_clock,
+                                            std::chrono::milliseconds>;
+
+struct Event {
+	timestamp_t at;
+	std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>
+	  logged;
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<Event> {
+		static constexpr char const at[] = "at";
+		static constexpr char const logged[] = "logged";
+
+		using at_t = json_date<at, timestamp_t>;
+
+		using type = json_member_list<
+		  at_t, json_date<logged, std::chrono::time_point<std::chrono::system_clock,
+		                                                  std::chrono::seconds>>>;
+
+		static auto to_json_data( Event const &e ) {
+			return std::forward_as_tuple( e.at, e.logged );
+		}
+	};
+} // namespace daw::json
+
+namespace daw::data_gen {
+	template<>
+	struct date_policy<daw::json::json_data_contract<Event>::at_t> {
+		static constexpr auto value =
+		  monotonic_dates{ 1'600'000'000'000, 1, 250 };
+	};
+} // namespace daw::data_gen
+
+using day_point_t = std::chrono::time_point<
+  std::chrono::system_clock,
+  std::chrono::duration<std::int64_t, std::ratio<86400>>>;
+using centi_point_t =
+  std::chrono::time_point<std::chrono::system_clock,
+                          std::chrono::duration<std::int64_t, std::centi>>;
+
+struct CoarseDates {
+	day_point_t day;
+	centi_point_t centi;
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<CoarseDates> {
+		static constexpr char const day[] = "day";
+		static constexpr char const centi[] = "centi";
+
+		using type = json_member_list<json_date<day, day_point_t>,
+		                              json_date<centi, centi_point_t>>;
+
+		static auto to_json_data( CoarseDates const &d ) {
+			return std::forward_as_tuple( d.day, d.centi );
+		}
+	};
+} // namespace daw::json
+
+struct Texts {
+	std::string plain;
+	std::string escapes;
+	std::string utf8;
+	std::string unicode_escapes;
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<Texts> {
+		static constexpr char const plain[] = "plain";
+		static constexpr char const escapes[] = "escapes";
+		static constexpr char const utf8[] = "utf8";
+		static constexpr char const unicode_escapes[] = "unicode_escapes";
+
+		using escapes_t = json_string<escapes>;
+		using utf8_t = json_string<utf8>;
+		using unicode_escapes_t = json_string<unicode_escapes>;
+
+		using type = json_member_list<json_string<plain>, escapes_t, utf8_t,
+		                              unicode_escapes_t>;
+
+		static auto to_json_data( Texts const &t ) {
+			return std::forward_as_tuple( t.plain, t.escapes, t.utf8,
+			                              t.unicode_escapes );
+		}
+	};
+} // namespace daw::json
+
+namespace daw::data_gen {
+	template<>
+	struct member_string_profile_policy<
+	  daw::json::json_data_contract<Texts>::escapes_t> {
+		static constexpr auto value = escape_heavy_strings;
+	};
+
+	template<>
+	struct member_string_profile_policy<
+	  daw::json::json_data_contract<Texts>::utf8_t> {
+		static constexpr auto value = utf8_strings;
+	};
+
+	template<>
+	struct member_string_profile_policy<
+	  daw::json::json_data_contract<Texts>::unicode_escapes_t> {
+		static constexpr auto value = unicode_escaped_strings;
+	};
+} // namespace daw::data_gen
+
+struct RawTexts {
+	std::string raw;
+	std::string escaped;
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<RawTexts> {
+		static constexpr char const raw[] = "raw";
+		static constexpr char const escaped[] = "escaped";
+
+		using type =
+		  json_member_list<json_string_raw<raw>, json_string<escaped>>;
+
+		static auto to_json_data( RawTexts const &t ) {
+			return std::forward_as_tuple( t.raw, t.escaped );
+		}
+	};
+} // namespace daw::json
+
+struct Measurements {
+	std::uint16_t sensor;
+	std::int64_t reading;
+	double huge_or_tiny;
+	double subnormal;
+	double count;
+	double price;
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<Measurements> {
+		static constexpr char const sensor[] = "sensor";
+		static constexpr char const reading[] = "reading";
+		static constexpr char const huge_or_tiny[] = "huge_or_tiny";
+		static constexpr char const subnormal[] = "subnormal";
+		static constexpr char const count[] = "count";
+		static constexpr char const price[] = "price";
+
+		using reading_t = json_number<reading, std::int64_t>;
+		using huge_or_tiny_t = json_number<huge_or_tiny>;
+		using subnormal_t = json_number<subnormal>;
+		using count_t = json_number<count>;
+		using price_t = json_number<price>;
+
+		using type =
+		  json_member_list<json_number<sensor, std::uint16_t>, reading_t,
+		                   huge_or_tiny_t, subnormal_t, count_t, price_t>;
+
+		static auto to_json_data( Measurements const &m ) {
+			return std::forward_as_tuple( m.sensor, m.reading, m.huge_or_tiny,
+			                              m.subnormal, m.count, m.price );
+		}
+	};
+} // namespace daw::json
+
+namespace daw::data_gen {
+	template<>
+	struct number_profile_policy<std::uint16_t> {
+		static constexpr auto value = uniform_int<std::uint16_t>{ 1, 64 };
+	};
+
+	using measurements_contract = daw::json::json_data_contract<Measurements>;
+
+	template<>
+	struct member_number_profile_policy<measurements_contract::reading_t> {
+		static constexpr auto value = digit_count_ints<std::int64_t>{ 1, 4 };
+	};
+
+	template<>
+	struct member_number_profile_policy<measurements_contract::huge_or_tiny_t> {
+		static constexpr auto value = exponent_reals<double>{ -300, 300 };
+	};
+
+	template<>
+	struct member_number_profile_policy<measurements_contract::subnormal_t> {
+		static constexpr auto value = subnormal_reals<double>{ };
+	};
+
+	template<>
+	struct member_number_profile_policy<measurements_contract::count_t> {
+		static constexpr auto value = integral_reals<double>{ 0, 1'000 };
+	};
+
+	template<>
+	struct member_number_profile_policy<measurements_contract::price_t> {
+		static constexpr auto value = decimal_reals<double>{ 100, 99'999, 2 };
+	};
+} // namespace daw::data_gen
+
+struct Sparse {
+	std::optional<int> always;
+	std::optional<int> never;
+	std::optional<std::int16_t> mostly;
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<Sparse> {
+		static constexpr char const always[] = "always";
+		static constexpr char const never[] = "never";
+		static constexpr char const mostly[] = "mostly";
+
+		using always_t = json_number_null<always, std::optional<int>>;
+		using never_t = json_number_null<never, std::optional<int>>;
+
+		using type = json_member_list<
+		  always_t, never_t, json_number_null<mostly, std::optional<std::int16_t>>>;
+
+		static auto to_json_data( Sparse const &s ) {
+			return std::forward_as_tuple( s.always, s.never, s.mostly );
+		}
+	};
+} // namespace daw::json
+
+namespace daw::data_gen {
+	template<>
+	struct null_rate_policy<std::optional<std::int16_t>> {
+		static constexpr auto value = null_ratio{ 9, 10 };
+	};
+
+	template<>
+	struct member_null_rate_policy<
+	  daw::json::json_data_contract<Sparse>::always_t> {
+		static constexpr auto value = always_null;
+	};
+
+	template<>
+	struct member_null_rate_policy<
+	  daw::json::json_data_contract<Sparse>::never_t> {
+		static constexpr auto value = never_null;
+	};
+} // namespace daw::data_gen
+
+struct Tree {
+	int value;
+	std::vector<Tree> children;
+};
+
+struct Chain {
+	int value;
+	std::unique_ptr<Chain> next;
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<Tree> {
+		static constexpr char const value[] = "value";
+		static constexpr char const children[] = "children";
+
+		using type =
+		  json_member_list<json_number<value, int>,
+		                   json_array<children, Tree, std::vector<Tree>>>;
+
+		static auto to_json_data( Tree const &t ) {
+			return std::forward_as_tuple( t.value, t.children );
+		}
+	};
+
+	template<>
+	struct json_data_contract<Chain> {
+		static constexpr char const value[] = "value";
+		static constexpr char const next[] = "next";
+
+		using type =
+		  json_member_list<json_number<value, int>,
+		                   json_class_null<next, std::unique_ptr<Chain>>>;
+
+		static auto to_json_data( Chain const &c ) {
+			return std::forward_as_tuple( c.value, c.next );
+		}
+	};
+} // namespace daw::json
+
+namespace daw::data_gen {
+	template<>
+	struct container_length_policy<std::vector<Tree>> {
+		static constexpr auto value = uniform_length{ 0, 4 };
+	};
+
+	template<>
+	struct null_rate_policy<std::unique_ptr<Chain>> {
+		static constexpr auto value = never_null;
+	};
+} // namespace daw::data_gen
+
+std::size_t tree_height( Tree const &t ) {
+	std::size_t result = 0;
+	for( auto const &child : t.children ) {
+		result = std::max( result, tree_height( child ) );
+	}
+	return result + 1U;
+}
+
+std::size_t tree_size( Tree const &t ) {
+	std::size_t result = 1;
+	for( auto const &child : t.children ) {
+		result += tree_size( child );
+	}
+	return result;
+}
+
+std::size_t json_nesting( std::string_view json ) {
+	std::size_t depth = 0;
+	std::size_t result = 0;
+	for( char c : json ) {
+		if( c == '[' or c == '{' ) {
+			result = std::max( result, ++depth );
+		} else if( c == ']' or c == '}' ) {
+			--depth;
+		}
+	}
+	return result;
+}
+
+struct Account {
+	std::string screen_name;
+	int followers;
+};
+
+struct Post {
+	Account user;
+	std::vector<Account> mentions;
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<Account> {
+		static constexpr char const screen_name[] = "screen_name";
+		static constexpr char const followers[] = "followers";
+
+		using screen_name_t = json_string<screen_name>;
+		using followers_t = json_number<followers, int>;
+
+		using type = json_member_list<screen_name_t, followers_t>;
+
+		static auto to_json_data( Account const &a ) {
+			return std::forward_as_tuple( a.screen_name, a.followers );
+		}
+	};
+
+	template<>
+	struct json_data_contract<Post> {
+		static constexpr char const user[] = "user";
+		static constexpr char const mentions[] = "mentions";
+
+		using type =
+		  json_member_list<json_class<user, Account>,
+		                   json_array<mentions, Account>>;
+
+		static auto to_json_data( Post const &p ) {
+			return std::forward_as_tuple( p.user, p.mentions );
+		}
+	};
+} // namespace daw::json
+
+namespace daw::data_gen {
+	using account_contract = daw::json::json_data_contract<Account>;
+
+	template<>
+	struct member_path_rules<account_contract::screen_name_t> {
+		static constexpr auto value =
+		  std::tuple{ path_rule{ "user.screen_name", uuid_text{ } },
+		              path_rule{ "mentions[].screen_name",
+		                         integer_text<int>{ 1, 9 } } };
+	};
+
+	template<>
+	struct member_path_rules<account_contract::followers_t> {
+		static constexpr auto value =
+		  std::tuple{ path_rule{ "user.followers", uniform_int<int>{ 0, 10 } } };
+	};
+} // namespace daw::data_gen
+
+/// @brief Generate JSON for T with and without a plan from the same seed,
+/// with the options that change how it is written
+template<typename T>
+bool plan_matches_template( std::uint64_t seed ) {
+	using namespace daw::data_gen;
+	auto templated = data_generator<T>( seed );
+	auto planned = data_generator<T>( seed );
+	templated.null_members( null_output::omit_member ).max_depth( 4 );
+	planned.null_members( null_output::omit_member ).max_depth( 4 );
+	auto expected = std::string( );
+	auto json = std::string( );
+	for( int n = 0; n < 10; ++n ) {
+		expected.clear( );
+		json.clear( );
+		templated.generate_json( expected );
+		planned.generate_json_with_plan( json );
+		if( json != expected ) {
+			return false;
+		}
+	}
+	auto eng = xoshiro256ss( seed );
+	auto plan_eng = xoshiro256ss( seed );
+	expected.clear( );
+	json.clear( );
+	generate_json_for<T>( expected, eng );
+	generate_json_with_plan<T>( json, plan_eng );
+	return json == expected and eng( ) == plan_eng( );
+}
+
 
 int main( ) {
 	using namespace daw::json;
@@ -92,6 +768,15 @@ int main( ) {
 	auto c = generate_data_for<Foo>( );
 	auto cv = generate_data_for<std::vector<Foo>>( );
 	auto bar = generate_data_for<Bar>( );
+	auto len_eng = std::mt19937_64( 1 );
+	for( int n = 0; n < 10; ++n ) {
+		auto lengths = generate_data_for<Lengths>( len_eng );
+		ensure( lengths.fixed_str.size( ) == 17 );
+		ensure( lengths.fixed_ary.size( ) == 1000 );
+		ensure( ( lengths.ranged_ary.size( ) >= 2 and
+		          lengths.ranged_ary.size( ) <= 4 ) or
+		        lengths.ranged_ary.size( ) == 8 );
+	}
 	auto bar_str =
 	  to_json( bar, options::output_flags<options::SerializationFormat::Pretty> );
 	(void)bar_str;
@@ -125,5 +810,648 @@ int main( ) {
 	  to_json( citm, citm_outf,
 	           options::output_flags<options::SerializationFormat::Pretty> );
 	}
+
+	std::string bar_json;
+	generate_json_for<Bar>( bar_json );
+	auto bar2 = from_json<Bar>( bar_json );
+	(void)bar2;
+	std::string geo_json;
+	generate_json_for<daw::geojson::FeatureCollection>( geo_json );
+	auto geo3 = from_json<daw::geojson::FeatureCollection>( geo_json );
+	(void)geo3;
+	std::string twit_json;
+	generate_json_for<daw::twitter::twitter_object_t>( twit_json );
+	auto twit3 = from_json<daw::twitter::twitter_object_t>( twit_json );
+	(void)twit3;
+	std::string citm_json;
+	generate_json_for<daw::citm::citm_object_t>( citm_json );
+	auto citm3 = from_json<daw::citm::citm_object_t>( citm_json );
+	(void)citm3;
+
+	// Each thread owns its engine, equal seeds must give equal documents
+	{
+		std::string thread_twit_str[2];
+		auto const gen_twit = [&]( std::size_t n ) {
+			auto eng = std::mt19937_64( 42 );
+			thread_twit_str[n] =
+			  to_json( generate_data_for<daw::twitter::twitter_object_t>( eng ) );
+		};
+		auto t0 = std::thread( gen_twit, 0 );
+		auto t1 = std::thread( gen_twit, 1 );
+		t0.join( );
+		t1.join( );
+		test_assert( thread_twit_str[0] == thread_twit_str[1],
+		             "Generation is not independent between threads" );
+	}
+
+	// A corpus must not depend on the number of threads generating it
+	{
+		constexpr std::size_t corpus_size = 100;
+		constexpr std::size_t shard_size = 8;
+		auto const gen_corpus = [&]( std::size_t threads ) {
+			auto shards = std::vector<std::string>(
+			  corpus_shard_count( corpus_size, shard_size ) );
+			generate_corpus<Bar>(
+			  corpus_size, 1234, threads,
+			  [&]( std::size_t shard ) -> std::string & { return shards[shard]; },
+			  shard_size );
+			return shards;
+		};
+		auto const corpus1 = gen_corpus( 1 );
+		auto const corpus4 = gen_corpus( 4 );
+		test_assert( corpus1 == corpus4,
+		             "Corpus output depends on the thread count" );
+		for( auto const &shard : corpus1 ) {
+			auto first = shard.data( );
+			auto const last = first + shard.size( );
+			while( first != last ) {
+				auto const eol = std::find( first, last, '\n' );
+				auto doc = from_json<Bar>(
+				  std::string_view( first, static_cast<std::size_t>( eol - first ) ) );
+				(void)doc;
+				first = eol + 1;
+			}
+		}
+	}
+
+	// Every allocator aware member must come from the arena
+	{
+		auto arena = std::pmr::monotonic_buffer_resource( );
+		auto eng = std::mt19937_64( 3 );
+		auto const doc = generate_data_for<ArenaBar>( arena, eng );
+		auto const in_arena = [&]( auto const &value ) {
+			return value.get_allocator( ).resource( ) == &arena;
+		};
+		test_assert( in_arena( doc.foos ) and in_arena( doc.names ),
+		             "Container not allocated from arena" );
+		for( auto const &foo : doc.foos ) {
+			test_assert( in_arena( foo.y ), "String not allocated from arena" );
+		}
+		for( auto const &[key, value] : doc.names ) {
+			test_assert( in_arena( key ) and in_arena( value ),
+			             "String not allocated from arena" );
+		}
+	}
+
+	// Generating into a fixed buffer cuts containers short to fit and must
+	// still give valid documents
+	{
+		auto eng = std::mt19937_64( 11 );
+		auto buffer = std::vector<char>( 16U * 1024U );
+		for( int n = 0; n < 10; ++n ) {
+			auto const size =
+			  generate_json_into<daw::twitter::twitter_object_t>( buffer, eng );
+			test_assert( size <= buffer.size( ), "Bounded buffer overrun" );
+			auto doc = from_json<daw::twitter::twitter_object_t>(
+			  std::string_view( buffer.data( ), size ) );
+			(void)doc;
+		}
+		char small_buffer[512];
+		for( int n = 0; n < 10; ++n ) {
+			auto const size = generate_json_into<std::vector<Bar>>(
+			  small_buffer, sizeof( small_buffer ), eng );
+			auto doc =
+			  from_json<std::vector<Bar>>( std::string_view( small_buffer, size ) );
+			(void)doc;
+		}
+	}
+
+	// A generator continues its engine between documents
+	{
+		auto gen = data_generator<Bar>( );
+		auto const first = to_json( gen( ) );
+		test_assert( first == to_json( generate_data_for<Bar>( ) ),
+		             "Default generator does not match generate_data_for" );
+		auto second = Bar{ };
+		gen.generate_into( second );
+		test_assert( first != to_json( second ),
+		             "Generator repeated a document" );
+		auto seeded0 = data_generator<Bar, std::mt19937_64>( 99 );
+		auto seeded1 = data_generator<Bar, std::mt19937_64>( 99 );
+		for( int n = 0; n < 3; ++n ) {
+			test_assert( to_json( seeded0( ) ) == to_json( seeded1( ) ),
+			             "Equally seeded generators diverged" );
+		}
+		std::string json;
+		seeded0.generate_json( json );
+		auto doc = from_json<Bar>( json );
+		(void)doc;
+	}
+
+	// Regenerating in place must give what generating would have
+	{
+		auto const check_regenerate = []( auto value ) {
+			using T = decltype( value );
+			auto eng0 = std::mt19937_64( 21 );
+			auto eng1 = std::mt19937_64( 21 );
+			for( int n = 0; n < 5; ++n ) {
+				regenerate( value, eng0 );
+				test_assert( to_json( value ) ==
+				               to_json( generate_data_for<T>( eng1 ) ),
+				             "Regenerated value differs from a generated one" );
+			}
+		};
+		check_regenerate( generate_data_for<Bar>( ) );
+		check_regenerate( generate_data_for<daw::geojson::FeatureCollection>( ) );
+		check_regenerate( generate_data_for<daw::twitter::twitter_object_t>( ) );
+		// Unordered map iteration order depends on their history, only check
+		// that the result is valid
+		auto gen = data_generator<daw::citm::citm_object_t>( );
+		auto citm_doc = gen( );
+		for( int n = 0; n < 5; ++n ) {
+			gen.generate_into( citm_doc );
+			auto parsed = from_json<daw::citm::citm_object_t>( to_json( citm_doc ) );
+			(void)parsed;
+		}
+	}
+
+	// Target size generation must land close to the requested size
+	{
+		auto const within = []( std::size_t size, std::size_t target ) {
+			auto const diff = size > target ? size - target : target - size;
+			return diff <= target / 50U;
+		};
+		auto eng = std::mt19937_64( 7 );
+		constexpr std::size_t target = 1024U * 1024U;
+		test_assert(
+		  within( to_json( generate_data_for<daw::geojson::FeatureCollection>(
+		                     target, eng ) )
+		            .size( ),
+		          target ),
+		  "geojson target size missed" );
+		test_assert(
+		  within(
+		    to_json( generate_data_for<daw::twitter::twitter_object_t>( target,
+		                                                                eng ) )
+		      .size( ),
+		    target ),
+		  "twitter target size missed" );
+		test_assert(
+		  within(
+		    to_json( generate_data_for<daw::citm::citm_object_t>( target, eng ) )
+		      .size( ),
+		    target ),
+		  "citm target size missed" );
+		test_assert( within( to_json( generate_data_for<std::vector<Bar>>(
+		                               64U * 1024U, eng ) )
+		                       .size( ),
+		                     64U * 1024U ),
+		             "Bar target size missed" );
+	}
+
+	// Engines must match their reference sequences
+	{
+		auto xoshiro = xoshiro256ss( std::array<std::uint64_t, 4>{ 1, 2, 3, 4 } );
+		test_assert( xoshiro( ) == 11520U and xoshiro( ) == 0U and
+		               xoshiro( ) == 1509978240U and
+		               xoshiro( ) == 1215971899390074240ULL,
+		             "xoshiro256** sequence is wrong" );
+		auto pcg = pcg32( 42, 54 );
+		test_assert( pcg( ) == 0xA15C'02B7U and pcg( ) == 0x7B47'F409U and
+		               pcg( ) == 0xBA1D'3330U and pcg( ) == 0x83D2'F293U,
+		             "pcg32 sequence is wrong" );
+		auto const block = philox4x32::generate_block( { 0, 0 }, { 0, 0, 0, 0 } );
+		test_assert( block[0] == 0x6627'E8D5U and block[1] == 0xE169'C58DU and
+		               block[2] == 0xBC57'AC4CU and block[3] == 0x9B00'DBD8U,
+		             "philox4x32-10 block is wrong" );
+	}
+
+	// A bulk fill must give the same words as drawing them one at a time, so
+	// documents do not depend on which the generators use
+	{
+		auto const check_fill = []( auto eng ) {
+			auto bulk = eng;
+			std::uint64_t words[7];
+			bulk.fill( words, words + 1 );
+			bulk.fill( words + 1, words + 7 );
+			for( auto word : words ) {
+				if( word != gen_random_word( eng ) ) {
+					return false;
+				}
+			}
+			return bulk == eng;
+		};
+		test_assert( check_fill( splitmix64( 5 ) ), "splitmix64 fill differs" );
+		test_assert( check_fill( xoshiro256ss( 5 ) ), "xoshiro256** fill differs" );
+		test_assert( check_fill( wyrand( 5 ) ), "wyrand fill differs" );
+		test_assert( check_fill( pcg32( 5 ) ), "pcg32 fill differs" );
+		test_assert( check_fill( philox4x32( 5 ) ), "philox4x32 fill differs" );
+
+		auto eng = philox4x32( 9 );
+		eng.discard( 5 );
+		auto seeked = philox4x32( 9 );
+		seeked.set_counter( 2 );
+		seeked( );
+		test_assert( eng( ) == seeked( ), "philox4x32 counter seek differs" );
+
+		auto jumped = xoshiro256ss( 9 );
+		jumped.jump( );
+		test_assert( jumped != xoshiro256ss( 9 ), "xoshiro256** jump is a no-op" );
+
+		auto fast0 = wyrand( 17 );
+		auto fast1 = wyrand( 17 );
+		test_assert( to_json( generate_data_for<Bar>( fast0 ) ) ==
+		               to_json( generate_data_for<Bar>( fast1 ) ),
+		             "Equal wyrand seeds gave different documents" );
+	}
+
+	// Distributions must give the same values on every platform
+	{
+		auto eng = xoshiro256ss( 1 );
+		auto const ints = uniform_int<int>{ -1000, 1000 };
+		for( int expected : { 406, 41, 148, -217, 395, -713 } ) {
+			test_assert( ints( eng ) == expected,
+			             "uniform_int sequence is wrong" );
+		}
+		test_assert( gen_unit_real<double>( eng ) == 0x1.23004ef8df51p-4,
+		             "gen_unit_real value is wrong" );
+		auto minstd = std::minstd_rand( 1 );
+		test_assert( gen_random_word( minstd ) == 0xE2B8'95F8'5847'C122ULL,
+		             "gen_random_word is wrong for engines with a partial range" );
+		auto const byte = uniform_int<signed char>{ -128, 127 };
+		bool saw_min = false;
+		bool saw_max = false;
+		for( int n = 0; n < 10000; ++n ) {
+			auto const value = byte( eng );
+			saw_min = saw_min or value == -128;
+			saw_max = saw_max or value == 127;
+		}
+		test_assert( saw_min and saw_max, "uniform_int misses its bounds" );
+	}
+
+	// The parse benchmark harness round trips a corpus per size bucket
+	{
+		auto opts = parse_bench_options{ };
+		opts.size_buckets = { 512U, 8U * 1024U };
+		opts.bucket_bytes = 32U * 1024U;
+		opts.warmup_runs = 0;
+		opts.runs = 3;
+		auto const results = run_parse_bench<Bar>( opts );
+		test_assert( results.size( ) == opts.size_buckets.size( ),
+		             "Missing parse benchmark buckets" );
+		for( auto const &r : results ) {
+			test_assert( r.json_bytes >= opts.bucket_bytes and
+			               r.document_count > 0,
+			             "Parse benchmark corpus is too small" );
+			test_assert( r.from_json.median > 0.0 and r.to_json.median > 0.0 and
+			               r.json_value.median > 0.0 and
+			               r.from_json.min <= r.from_json.max,
+			             "Parse benchmark statistics are wrong" );
+		}
+	}
+
+	// Variants pick alternatives by weight and tagged variants round trip
+	// with the tag of the alternative generated
+	{
+		auto eng = xoshiro256ss( 3 );
+		std::size_t counts[3] = { };
+		std::size_t squares = 0;
+		for( int n = 0; n < 1000; ++n ) {
+			auto const shapes = generate_data_for<Shapes>( eng );
+			++counts[shapes.label.index( )];
+			squares += shapes.shape.index( );
+			auto const json = to_json( shapes );
+			test_assert( to_json( from_json<Shapes>( json ) ) == json,
+			             "Variant members do not round trip" );
+		}
+		test_assert( counts[0] == 0,
+		             "A variant alternative of weight 0 was generated" );
+		test_assert( counts[2] > counts[1], "variant_weights are ignored" );
+		test_assert( squares > 0 and squares < 1000,
+		             "A tagged variant alternative is never generated" );
+
+		auto json = std::string( );
+		generate_json_for<Shapes>( json, eng );
+		auto const shapes = from_json<Shapes>( json );
+		test_assert( shapes.label.index( ) != 0,
+		             "Generated JSON has an alternative of weight 0" );
+
+		for( std::uint64_t seed = 0; seed < 100; ++seed ) {
+			auto data_eng = xoshiro256ss( seed );
+			auto json_eng = xoshiro256ss( seed );
+			auto streamed = std::string( );
+			generate_json_for<Shapes>( streamed, json_eng );
+			test_assert( streamed == to_json( generate_data_for<Shapes>( data_eng ) ),
+			             "Streamed tagged variants differ from generated ones" );
+		}
+	}
+
+	// Intrusive variants hold the tag of the alternative generated
+	{
+		for( std::uint64_t seed = 0; seed < 100; ++seed ) {
+			auto data_eng = xoshiro256ss( seed );
+			auto json_eng = xoshiro256ss( seed );
+			auto const pets = generate_data_for<Pets>( data_eng );
+			auto const kind = std::visit(
+			  []( auto const &p ) {
+				  return p.kind;
+			  },
+			  pets.pet );
+			test_assert( kind == static_cast<int>( pets.pet.index( ) ) + 1,
+			             "An intrusive variant has the wrong tag" );
+			auto const json = to_json( pets );
+			test_assert( to_json( from_json<Pets>( json ) ) == json,
+			             "Intrusive variants do not round trip" );
+			auto streamed = std::string( );
+			generate_json_for<Pets>( streamed, json_eng );
+			test_assert( streamed == json,
+			             "Streamed intrusive variants differ from generated ones" );
+		}
+	}
+
+	// Custom members are generated by their text generators and parsed by
+	// their converters
+	{
+		auto eng = xoshiro256ss( 4 );
+		for( int n = 0; n < 100; ++n ) {
+			auto const order = generate_data_for<Order>( eng );
+			test_assert( order.id.text.size( ) == 36 and order.id.text[14] == '4',
+			             "Custom member is not a uuid" );
+			test_assert( order.placed.text.size( ) == 20 and
+			               order.placed.text[10] == 'T' and
+			               order.placed.text.back( ) == 'Z' and
+			               order.placed.text >= "2000" and
+			               order.placed.text < "2030",
+			             "Custom member is not an ISO 8601 timestamp" );
+			auto const &price = order.price.text;
+			test_assert( price.size( ) >= 4 and price.size( ) <= 5 and
+			               price[price.size( ) - 3U] == '.',
+			             "Custom member is not a decimal" );
+		}
+		auto json = std::string( );
+		generate_json_for<Order>( json, eng );
+		auto const order = from_json<Order>( json );
+		test_assert( to_json( order ) == json,
+		             "Generated custom members do not round trip" );
+	}
+
+	// Dates follow their policy, monotonic dates continue across the documents
+	// of a data_generator
+	{
+		auto gen = data_generator<Event>( 8 );
+		auto last = timestamp_t( );
+		for( int n = 0; n < 1000; ++n ) {
+			auto const event = gen( );
+			test_assert( event.at > last, "Monotonic dates are not increasing" );
+			test_assert( event.at - last <= std::chrono::milliseconds( 250 ) or
+			               n == 0,
+			             "Monotonic dates step too far" );
+			last = event.at;
+			auto const logged = event.logged.time_since_epoch( ).count( );
+			test_assert( logged >= 946'684'800 and logged < 1'893'456'000,
+			             "Uniform dates are out of range" );
+		}
+		auto json = std::string( );
+		gen.generate_json( json );
+		auto const event = from_json<Event>( json );
+		test_assert( event.at > last, "Generated JSON dates are not monotonic" );
+		auto const reparsed = from_json<Event>( to_json( event ) );
+		test_assert( reparsed.at == event.at and reparsed.logged == event.logged,
+		             "Generated dates do not round trip" );
+	}
+
+	// Dates coarser than a millisecond are written to the precision of their
+	// time_point, so the text and the value from the same seed agree
+	for( std::uint64_t seed = 0; seed < 100; ++seed ) {
+		auto json = std::string( );
+		auto written_eng = xoshiro256ss( seed );
+		generate_json_for<CoarseDates>( json, written_eng );
+		auto value_eng = xoshiro256ss( seed );
+		auto const expected = generate_data_for<CoarseDates>( value_eng );
+		auto const dates = from_json<CoarseDates>( json );
+		test_assert( dates.day == expected.day and dates.centi == expected.centi,
+		             "Generated JSON dates differ from generated values" );
+		auto const day_pos = json.find( "\"day\":\"" );
+		test_assert( day_pos != std::string::npos and
+		               json.compare( day_pos + 17U, 11U, "T00:00:00Z\"" ) == 0,
+		             "A date of whole days has a time of day" );
+		auto const centi_pos = json.find( "\"centi\":\"" );
+		test_assert( centi_pos != std::string::npos and
+		               json[centi_pos + 28U] == '.' and
+		               json[centi_pos + 31U] == 'Z',
+		             "A centisecond date does not have 2 fraction digits" );
+	}
+
+	// String profiles choose the characters, generated JSON escapes them so
+	// they parse back to the generated values
+	{
+		auto eng = xoshiro256ss( 6 );
+		std::size_t escapes = 0;
+		std::size_t escape_total = 0;
+		bool plain_is_ascii = true;
+		bool has_multi_byte = false;
+		for( int n = 0; n < 200; ++n ) {
+			auto const texts = generate_data_for<Texts>( eng );
+			for( char c : texts.plain ) {
+				plain_is_ascii = plain_is_ascii and
+				                 static_cast<unsigned char>( c ) < 0x80U and
+				                 c != '"' and c != '\\';
+			}
+			for( char c : texts.escapes ) {
+				escapes += c == '"' or c == '\\' or
+				           static_cast<unsigned char>( c ) < 0x20U;
+				++escape_total;
+			}
+			for( char c : texts.utf8 ) {
+				has_multi_byte =
+				  has_multi_byte or static_cast<unsigned char>( c ) >= 0xF0U;
+			}
+		}
+		test_assert( plain_is_ascii, "ascii_strings made a character to escape" );
+		test_assert( escapes * 5U > escape_total and escapes * 3U < escape_total,
+		             "escape_heavy_strings has the wrong density" );
+		test_assert( has_multi_byte, "utf8_strings made no 4 byte characters" );
+
+		auto json = std::string( );
+		auto written_eng = xoshiro256ss( 7 );
+		generate_json_for<Texts>( json, written_eng );
+		auto value_eng = xoshiro256ss( 7 );
+		auto const expected = generate_data_for<Texts>( value_eng );
+		auto const texts = from_json<Texts>( json );
+		test_assert( texts.plain == expected.plain and
+		               texts.escapes == expected.escapes and
+		               texts.utf8 == expected.utf8 and
+		               texts.unicode_escapes == expected.unicode_escapes,
+		             "Generated JSON strings differ from generated values" );
+
+		// The escapes member also writes \u00XX, so look at unicode_escapes only
+		bool has_surrogate_escape = false;
+		for( std::uint64_t seed = 0; seed < 20; ++seed ) {
+			json.clear( );
+			auto text_eng = xoshiro256ss( seed );
+			generate_json_for<Texts>( json, text_eng );
+			constexpr auto name = std::string_view( "\"unicode_escapes\":\"" );
+			auto const first = json.find( name ) + name.size( );
+			auto const raw = std::string_view( json ).substr(
+			  first, json.find( '"', first ) - first );
+			for( char c : raw ) {
+				test_assert( static_cast<unsigned char>( c ) < 0x80U,
+				             "unicode_escaped_strings wrote raw UTF-8" );
+			}
+			for( auto pos = raw.find( "\\uD" ); pos != std::string_view::npos;
+			     pos = raw.find( "\\uD", pos + 1U ) ) {
+				auto const unit = pos + 3U < raw.size( ) ? raw[pos + 3U] : '0';
+				has_surrogate_escape =
+				  has_surrogate_escape or ( unit >= '8' and unit <= '9' ) or
+				  ( unit >= 'A' and unit <= 'B' );
+			}
+		}
+		test_assert( has_surrogate_escape,
+		             "unicode_escaped_strings wrote no surrogate pair escapes" );
+	}
+
+	// Raw strings are written unescaped, as to_json writes them
+	for( std::uint64_t seed = 0; seed < 20; ++seed ) {
+		auto json = std::string( );
+		auto written_eng = xoshiro256ss( seed );
+		generate_json_for<RawTexts>( json, written_eng );
+		auto value_eng = xoshiro256ss( seed );
+		test_assert( json == to_json( generate_data_for<RawTexts>( value_eng ) ),
+		             "Generated raw strings differ from to_json" );
+	}
+
+	// Number profiles shape the numbers of a type or a member
+	{
+		auto eng = xoshiro256ss( 10 );
+		bool saw_huge = false;
+		bool saw_tiny = false;
+		for( int n = 0; n < 1000; ++n ) {
+			auto const m = generate_data_for<Measurements>( eng );
+			test_assert( m.sensor >= 1 and m.sensor <= 64,
+			             "number_profile_policy is ignored" );
+			test_assert( m.reading > -10'000 and m.reading < 10'000,
+			             "digit_count_ints has too many digits" );
+			auto const magnitude = std::fabs( m.huge_or_tiny );
+			test_assert( magnitude >= 1e-300 and magnitude < 1e301,
+			             "exponent_reals is out of range" );
+			saw_huge = saw_huge or magnitude > 1e100;
+			saw_tiny = saw_tiny or magnitude < 1e-100;
+			test_assert( std::fpclassify( m.subnormal ) == FP_SUBNORMAL,
+			             "subnormal_reals is not subnormal" );
+			test_assert( m.count == std::floor( m.count ) and m.count >= 0.0 and
+			               m.count <= 1000.0,
+			             "integral_reals is not whole" );
+			test_assert( m.price >= 1.0 and m.price < 1000.0 and
+			               std::round( m.price * 100.0 ) / 100.0 == m.price,
+			             "decimal_reals has more than 2 places" );
+		}
+		test_assert( saw_huge and saw_tiny,
+		             "exponent_reals misses large exponents" );
+	}
+
+	// Null rates are set per type or member, and null members can be left
+	// out of generated JSON text
+	{
+		auto eng = xoshiro256ss( 11 );
+		int mostly_null = 0;
+		for( int n = 0; n < 1000; ++n ) {
+			auto const s = generate_data_for<Sparse>( eng );
+			test_assert( not s.always and s.never,
+			             "member_null_rate_policy is ignored" );
+			mostly_null += s.mostly ? 0 : 1;
+		}
+		test_assert( mostly_null > 850 and mostly_null < 950,
+		             "null_rate_policy has the wrong rate" );
+
+		auto gen = data_generator<Sparse>( 11 );
+		auto json = std::string( );
+		gen.generate_json( json );
+		test_assert( json.find( "\"always\":null" ) != std::string::npos,
+		             "Null members are not written as null" );
+		gen.null_members( null_output::omit_member );
+		for( int n = 0; n < 100; ++n ) {
+			json.clear( );
+			gen.generate_json( json );
+			test_assert( json.rfind( "{\"never\":", 0 ) == 0 and
+			               json.find( "null" ) == std::string::npos,
+			             "Omitted null members are written" );
+			auto const s = from_json<Sparse>( json );
+			test_assert( not s.always and s.never,
+			             "JSON with omitted members does not parse" );
+		}
+	}
+
+	// Depth and element limits bound recursive data contracts
+	{
+		auto gen = data_generator<Tree>( 12 );
+		gen.max_depth( 5 );
+		auto json = std::string( );
+		for( int n = 0; n < 100; ++n ) {
+			test_assert( tree_height( gen( ) ) <= 3,
+			             "Arrays are not cut off at max_depth" );
+			json.clear( );
+			gen.generate_json( json );
+			// An empty array of a class at the limit is one level deeper
+			test_assert( json_nesting( json ) <= 6,
+			             "Generated JSON is nested too deep" );
+		}
+		gen.max_depth( 0 ).max_elements( 40 );
+		for( int n = 0; n < 100; ++n ) {
+			test_assert( tree_size( gen( ) ) <= 41,
+			             "max_elements is exceeded" );
+		}
+
+		auto chains = data_generator<Chain>( 12 );
+		chains.max_depth( 8 );
+		auto const chain = chains( );
+		std::size_t length = 0;
+		for( auto link = &chain; link != nullptr; link = link->next.get( ) ) {
+			++length;
+		}
+		test_assert( length == 8, "Nullable classes are not cut off" );
+	}
+
+	// Path rules generate a member depending on where it is in the document.
+	// Only contracts with rules inside them track the path
+	{
+		static_assert( datagen_details::path_rules_inside_v<
+		               datagen_details::root_json_member<Post>> );
+		static_assert( not datagen_details::path_rules_inside_v<
+		               datagen_details::root_json_member<Bar>> );
+		static_assert( not datagen_details::path_rules_inside_v<
+		               datagen_details::root_json_member<Tree>> );
+		auto eng = xoshiro256ss( 13 );
+		for( int n = 0; n < 100; ++n ) {
+			auto const post = generate_data_for<Post>( eng );
+			test_assert( post.user.screen_name.size( ) == 36 and
+			               post.user.followers >= 0 and post.user.followers <= 10,
+			             "Path rules of user are ignored" );
+			for( auto const &mention : post.mentions ) {
+				test_assert( mention.screen_name.size( ) == 1 and
+				               mention.screen_name != "0",
+				             "Path rules of mentions[] are ignored" );
+			}
+		}
+
+		auto values = data_generator<Post>( 3 );
+		auto regenerated = data_generator<Post>( 3 );
+		auto written = data_generator<Post>( 3 );
+		auto post = Post{ };
+		auto json = std::string( );
+		for( int n = 0; n < 10; ++n ) {
+			auto const expected = values( );
+			regenerated.generate_into( post );
+			json.clear( );
+			written.generate_json( json );
+			auto const parsed = from_json<Post>( json );
+			test_assert( post.user.screen_name == expected.user.screen_name and
+			               parsed.user.screen_name == expected.user.screen_name and
+			               parsed.mentions.size( ) == expected.mentions.size( ),
+			             "Path rules draw differently when writing JSON" );
+		}
+	}
+	// A plan writes the same JSON as the template path, draw for draw
+	{
+		test_assert( plan_matches_template<Tree>( 14 ) and
+		               plan_matches_template<Chain>( 14 ) and
+		               plan_matches_template<Sparse>( 14 ) and
+		               plan_matches_template<Post>( 14 ) and
+		               plan_matches_template<daw::twitter::twitter_object_t>(
+		                 14 ) and
+		               plan_matches_template<daw::citm::citm_object_t>( 14 ) and
+		               plan_matches_template<daw::geojson::FeatureCollection>(
+		                 14 ),
+		             "The plan writes different JSON" );
+	}
 	return 0;
 }